@@ -0,0 +1,124 @@
+#pragma once
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace LinearAlgebra
+{
+	namespace detail
+	{
+		//integer element types get exact, overflow checked kernels instead of the generic ones
+		template <typename T>
+		constexpr bool isExactInteger = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+		//widest integer of the same signedness, used to accumulate integer fields
+		template <typename T>
+		using Widened = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+
+		//signed integer holding every value of the element types, for eliminations whose intermediate values may be negative
+#if defined(__SIZEOF_INT128__)
+		__extension__ typedef __int128 SignedWidened;
+#else
+		typedef long long SignedWidened;
+#endif
+
+		[[noreturn]] inline void overflow()
+		{
+			throw std::overflow_error("Integer overflow in matrix arithmetic!");
+		}
+
+		template <typename W>
+		W checkedAdd(W a, W b)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			W r;
+			if (__builtin_add_overflow(a, b, &r))
+			{
+				overflow();
+			}
+			return r;
+#else
+			if constexpr (std::is_signed_v<W>)
+			{
+				if ((b > 0 && a > std::numeric_limits<W>::max() - b) || (b < 0 && a < std::numeric_limits<W>::min() - b))
+				{
+					overflow();
+				}
+			}
+			else if (a > std::numeric_limits<W>::max() - b)
+			{
+				overflow();
+			}
+			return a + b;
+#endif
+		}
+
+		template <typename W>
+		W checkedSub(W a, W b)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			W r;
+			if (__builtin_sub_overflow(a, b, &r))
+			{
+				overflow();
+			}
+			return r;
+#else
+			if constexpr (std::is_signed_v<W>)
+			{
+				if ((b < 0 && a > std::numeric_limits<W>::max() + b) || (b > 0 && a < std::numeric_limits<W>::min() + b))
+				{
+					overflow();
+				}
+			}
+			else if (a < b)
+			{
+				overflow();
+			}
+			return a - b;
+#endif
+		}
+
+		template <typename W>
+		W checkedMul(W a, W b)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			W r;
+			if (__builtin_mul_overflow(a, b, &r))
+			{
+				overflow();
+			}
+			return r;
+#else
+			if (a == 0 || b == 0)
+			{
+				return 0;
+			}
+			if constexpr (std::is_signed_v<W>)
+			{
+				const W max = std::numeric_limits<W>::max(), min = std::numeric_limits<W>::min();
+				if ((a > 0 && b > 0 && a > max / b) || (a > 0 && b < 0 && b < min / a) || (a < 0 && b > 0 && a < min / b) || (a < 0 && b < 0 && b < max / a))
+				{
+					overflow();
+				}
+			}
+			else if (a > std::numeric_limits<W>::max() / b)
+			{
+				overflow();
+			}
+			return a * b;
+#endif
+		}
+
+		//converts accumulated value back to the element type, throws if it does not fit
+		template <typename T, typename W>
+		T narrow(W value)
+		{
+			if (value < W(std::numeric_limits<T>::min()) || value > W(std::numeric_limits<T>::max()))
+			{
+				overflow();
+			}
+			return T(value);
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#ifdef MATRIX_HAS_CBLAS
+#include <cblas.h>
+#endif
+#ifdef MATRIX_HAS_LAPACKE
+#include <lapacke.h>
+#endif
+
+namespace LinearAlgebra
+{
+	//implementation running the kernels of Matrix<float> and Matrix<double>,
+	//every other element type always uses the built-in templates
+	enum class Backend { Builtin, Blas };
+
+	//returns true iff the library was built against CBLAS
+	constexpr bool blasAvailable() noexcept
+	{
+#ifdef MATRIX_HAS_CBLAS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	//returns true iff the library was built against LAPACKE, the decompositions use it together with the Blas backend
+	constexpr bool lapackAvailable() noexcept
+	{
+#ifdef MATRIX_HAS_LAPACKE
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	namespace detail
+	{
+		//MATRIX_BACKEND environment variable ("builtin" or "blas") picks the initial backend, Blas is the default when available
+		inline Backend initialBackend() noexcept
+		{
+			const char* requested = std::getenv("MATRIX_BACKEND");
+			if (requested && std::string(requested) == "builtin")
+			{
+				return Backend::Builtin;
+			}
+			return blasAvailable() ? Backend::Blas : Backend::Builtin;
+		}
+
+		inline std::atomic<Backend>& selectedBackend() noexcept
+		{
+			static std::atomic<Backend> selected(initialBackend());
+			return selected;
+		}
+	}
+
+	inline Backend getBackend() noexcept
+	{
+		return detail::selectedBackend().load(std::memory_order_relaxed);
+	}
+
+	//switches the backend for all subsequent operations
+	inline void setBackend(Backend backend) noexcept(false)
+	{
+		if (backend == Backend::Blas && !blasAvailable())
+		{
+			throw std::invalid_argument("Library was built without BLAS support!");
+		}
+		detail::selectedBackend().store(backend, std::memory_order_relaxed);
+	}
+
+	namespace detail
+	{
+		//returns true iff operations on T are routed to the vendor library
+		template <typename T>
+		bool useBlas() noexcept
+		{
+			return (std::is_same_v<T, float> || std::is_same_v<T, double>) && blasAvailable() && getBackend() == Backend::Blas;
+		}
+
+		template <typename T>
+		bool useLapack() noexcept
+		{
+			return lapackAvailable() && useBlas<T>();
+		}
+	}
+}
@@ -0,0 +1,706 @@
+#pragma once
+#include "Matrix.hpp"
+#include "Fill.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	//eigenpairs of a symmetric matrix, i-th column of vectors belongs to values[i]
+	template <typename T>
+	struct EigenDecomposition
+	{
+		std::vector<T> values;
+		Matrix<T> vectors;
+	};
+
+	//thin singular value decomposition A = U * diag(S) * V^T, singular values in descending order
+	template <typename T>
+	struct SingularValueDecomposition
+	{
+		Matrix<T> U;
+		std::vector<T> S;
+		Matrix<T> V;
+	};
+
+	//full eigendecomposition of a symmetric matrix (Householder tridiagonalization followed by implicit QL),
+	//only the lower triangle is referenced, eigenvalues are sorted in descending order
+	template <typename T>
+	EigenDecomposition<T> symmetricEigen(const Matrix<T>& A, bool computeVectors = true) noexcept(false);
+
+	//thin SVD of an arbitrary matrix computed with one-sided Jacobi rotations
+	template <typename T>
+	SingularValueDecomposition<T> svd(const Matrix<T>& A) noexcept(false);
+
+	//k eigenpairs of largest magnitude of a symmetric matrix by block power (subspace) iteration
+	template <typename T>
+	EigenDecomposition<T> powerIteration(const Matrix<T>& A, size_t k, size_t maxIterations = 1000, T tolerance = std::sqrt(std::numeric_limits<T>::epsilon()), std::uint64_t seed = 0) noexcept(false);
+
+	//k eigenpairs of largest magnitude of a symmetric matrix by Lanczos with full reorthogonalization,
+	//steps is the dimension of the Krylov subspace (0 picks it automatically)
+	template <typename T>
+	EigenDecomposition<T> lanczos(const Matrix<T>& A, size_t k, size_t steps = 0, std::uint64_t seed = 0) noexcept(false);
+
+	//k leading singular triplets by randomized range finder (Halko, Martinsson, Tropp)
+	template <typename T>
+	SingularValueDecomposition<T> randomizedSVD(const Matrix<T>& A, size_t k, size_t oversampling = 10, size_t powerIterations = 2, std::uint64_t seed = 0) noexcept(false);
+
+	namespace detail
+	{
+		template <typename T>
+		T rowDot(const Matrix<T>& A, size_t i, const Matrix<T>& B, size_t j) noexcept
+		{
+			T s(0);
+			for (size_t c = 0; c < A.getCountColumns(); c++)
+			{
+				s += A(i, c) * B(j, c);
+			}
+			return s;
+		}
+
+		//modified Gram-Schmidt over the rows of Q (applied twice for numerical orthogonality),
+		//rows that turn out linearly dependent are zeroed
+		template <typename T>
+		void orthonormalizeRows(Matrix<T>& Q) noexcept(false)
+		{
+			const size_t n = Q.getCountColumns(), stride = Q.getStride();
+			T* const fields = Q.data();
+			for (size_t i = 0; i < Q.getCountRows(); i++)
+			{
+				T* row = fields + i * stride;
+				T original = std::sqrt(rowDot(Q, i, Q, i));
+				for (int pass = 0; pass < 2; pass++)
+				{
+					for (size_t j = 0; j < i; j++)
+					{
+						T projection = rowDot(Q, i, Q, j);
+						const T* other = fields + j * stride;
+						for (size_t c = 0; c < n; c++)
+						{
+							row[c] -= projection * other[c];
+						}
+					}
+				}
+				T norm = std::sqrt(rowDot(Q, i, Q, i));
+				bool dependent = norm <= std::numeric_limits<T>::epsilon() * original * T(n) || norm == T(0);
+				for (size_t c = 0; c < n; c++)
+				{
+					row[c] = dependent ? T(0) : row[c] / norm;
+				}
+			}
+		}
+
+		//selects the given columns of M in the given order
+		template <typename T>
+		Matrix<T> selectColumns(const Matrix<T>& M, const std::vector<size_t>& order)
+		{
+			Matrix<T> R(M.getCountRows(), order.size());
+			for (size_t i = 0; i < M.getCountRows(); i++)
+			{
+				for (size_t j = 0; j < order.size(); j++)
+				{
+					R(i, j) = M(i, order[j]);
+				}
+			}
+			return R;
+		}
+
+		//keeps the k eigenpairs of largest magnitude, ordered by descending magnitude
+		template <typename T>
+		EigenDecomposition<T> dominantPairs(const EigenDecomposition<T>& E, size_t k)
+		{
+			std::vector<size_t> order(E.values.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return std::abs(E.values[a]) > std::abs(E.values[b]); });
+			order.resize(k);
+			EigenDecomposition<T> R;
+			for (size_t i : order)
+			{
+				R.values.push_back(E.values[i]);
+			}
+			R.vectors = selectColumns(E.vectors, order);
+			return R;
+		}
+
+		template <typename T>
+		void checkFloatingPoint()
+		{
+			static_assert(std::is_floating_point_v<T>, "Decompositions are defined for floating point matrices only!");
+		}
+
+#ifdef MATRIX_HAS_LAPACKE
+		//symmetric eigendecomposition by LAPACK divide and conquer (?syevd), nonempty A
+		template <typename T>
+		EigenDecomposition<T> lapackSymmetricEigen(const Matrix<T>& A, bool computeVectors)
+		{
+			const size_t n = A.getCountRows();
+			Matrix<T> V(A);
+			std::vector<T> w(n);
+			lapack_int info;
+			if constexpr (std::is_same_v<T, float>)
+			{
+				info = LAPACKE_ssyevd(LAPACK_ROW_MAJOR, computeVectors ? 'V' : 'N', 'L', lapack_int(n), V.data(), lapack_int(V.getStride()), w.data());
+			}
+			else
+			{
+				info = LAPACKE_dsyevd(LAPACK_ROW_MAJOR, computeVectors ? 'V' : 'N', 'L', lapack_int(n), V.data(), lapack_int(V.getStride()), w.data());
+			}
+			if (info != 0)
+			{
+				throw std::runtime_error("Symmetric eigensolver did not converge!");
+			}
+			//LAPACK sorts ascending
+			std::vector<size_t> order(n);
+			std::iota(order.rbegin(), order.rend(), 0);
+			EigenDecomposition<T> result;
+			for (size_t i : order)
+			{
+				result.values.push_back(w[i]);
+			}
+			if (computeVectors)
+			{
+				result.vectors = selectColumns(V, order);
+			}
+			return result;
+		}
+
+		//thin SVD by LAPACK divide and conquer (?gesdd), nonempty A
+		template <typename T>
+		SingularValueDecomposition<T> lapackSVD(const Matrix<T>& A)
+		{
+			const size_t m = A.getCountRows(), n = A.getCountColumns(), k = std::min(m, n);
+			Matrix<T> work(A);
+			SingularValueDecomposition<T> result{ Matrix<T>(m, k, Uninitialized), std::vector<T>(k), Matrix<T>() };
+			Matrix<T> Vt(k, n, Uninitialized);
+			lapack_int info;
+			if constexpr (std::is_same_v<T, float>)
+			{
+				info = LAPACKE_sgesdd(LAPACK_ROW_MAJOR, 'S', lapack_int(m), lapack_int(n), work.data(), lapack_int(work.getStride()), result.S.data(), result.U.data(), lapack_int(k), Vt.data(), lapack_int(n));
+			}
+			else
+			{
+				info = LAPACKE_dgesdd(LAPACK_ROW_MAJOR, 'S', lapack_int(m), lapack_int(n), work.data(), lapack_int(work.getStride()), result.S.data(), result.U.data(), lapack_int(k), Vt.data(), lapack_int(n));
+			}
+			if (info != 0)
+			{
+				throw std::runtime_error("SVD did not converge!");
+			}
+			result.V = Vt.transposed();
+			return result;
+		}
+#endif
+	}
+
+	template <typename T>
+	EigenDecomposition<T> symmetricEigen(const Matrix<T>& A, bool computeVectors) noexcept(false)
+	{
+		detail::checkFloatingPoint<T>();
+		if (A.getCountRows() != A.getCountColumns())
+		{
+			throw std::domain_error("Eigendecomposition is undefined for non square matrix!");
+		}
+		const size_t n = A.getCountRows();
+		EigenDecomposition<T> result;
+		if (n == 0)
+		{
+			return result;
+		}
+#ifdef MATRIX_HAS_LAPACKE
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			if (detail::useLapack<T>())
+			{
+				return detail::lapackSymmetricEigen(A, computeVectors);
+			}
+		}
+#endif
+		Matrix<T> vectors(n, n);
+		//the fields are taken once, indexing the matrix itself would check for shared fields on every access
+		T* const fields = vectors.data();
+		auto V = [fields, n](size_t i, size_t j) -> T& { return fields[i * n + j]; };
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = 0; j <= i; j++)
+			{
+				V(i, j) = A(i, j);
+				V(j, i) = A(i, j);
+			}
+		}
+		std::vector<T> d(n), e(n);
+
+		//Householder reduction to tridiagonal form
+		for (size_t j = 0; j < n; j++)
+		{
+			d[j] = V(n - 1, j);
+		}
+		for (size_t i = n - 1; i > 0; i--)
+		{
+			T scale(0), h(0);
+			for (size_t k = 0; k < i; k++)
+			{
+				scale += std::abs(d[k]);
+			}
+			if (scale == T(0))
+			{
+				e[i] = d[i - 1];
+				for (size_t j = 0; j < i; j++)
+				{
+					d[j] = V(i - 1, j);
+					V(i, j) = T(0);
+					V(j, i) = T(0);
+				}
+			}
+			else
+			{
+				for (size_t k = 0; k < i; k++)
+				{
+					d[k] /= scale;
+					h += d[k] * d[k];
+				}
+				T f = d[i - 1];
+				T g = std::sqrt(h);
+				if (f > T(0))
+				{
+					g = -g;
+				}
+				e[i] = scale * g;
+				h -= f * g;
+				d[i - 1] = f - g;
+				for (size_t j = 0; j < i; j++)
+				{
+					e[j] = T(0);
+				}
+				for (size_t j = 0; j < i; j++)
+				{
+					f = d[j];
+					V(j, i) = f;
+					g = e[j] + V(j, j) * f;
+					for (size_t k = j + 1; k < i; k++)
+					{
+						g += V(k, j) * d[k];
+						e[k] += V(k, j) * f;
+					}
+					e[j] = g;
+				}
+				f = T(0);
+				for (size_t j = 0; j < i; j++)
+				{
+					e[j] /= h;
+					f += e[j] * d[j];
+				}
+				T hh = f / (h + h);
+				for (size_t j = 0; j < i; j++)
+				{
+					e[j] -= hh * d[j];
+				}
+				for (size_t j = 0; j < i; j++)
+				{
+					f = d[j];
+					g = e[j];
+					for (size_t k = j; k < i; k++)
+					{
+						V(k, j) -= (f * e[k] + g * d[k]);
+					}
+					d[j] = V(i - 1, j);
+					V(i, j) = T(0);
+				}
+			}
+			d[i] = h;
+		}
+		if (computeVectors)
+		{
+			//accumulation of the transformations
+			for (size_t i = 0; i + 1 < n; i++)
+			{
+				V(n - 1, i) = V(i, i);
+				V(i, i) = T(1);
+				T h = d[i + 1];
+				if (h != T(0))
+				{
+					for (size_t k = 0; k <= i; k++)
+					{
+						d[k] = V(k, i + 1) / h;
+					}
+					for (size_t j = 0; j <= i; j++)
+					{
+						T g(0);
+						for (size_t k = 0; k <= i; k++)
+						{
+							g += V(k, i + 1) * V(k, j);
+						}
+						for (size_t k = 0; k <= i; k++)
+						{
+							V(k, j) -= g * d[k];
+						}
+					}
+				}
+				for (size_t k = 0; k <= i; k++)
+				{
+					V(k, i + 1) = T(0);
+				}
+			}
+			for (size_t j = 0; j < n; j++)
+			{
+				d[j] = V(n - 1, j);
+				V(n - 1, j) = T(0);
+			}
+			V(n - 1, n - 1) = T(1);
+		}
+		else
+		{
+			//without vectors only the diagonal of the tridiagonal matrix is needed
+			for (size_t i = 0; i < n; i++)
+			{
+				d[i] = V(i, i);
+			}
+		}
+		e[0] = T(0);
+
+		//implicit QL iterations on the tridiagonal matrix
+		for (size_t i = 1; i < n; i++)
+		{
+			e[i - 1] = e[i];
+		}
+		e[n - 1] = T(0);
+		const T eps = std::numeric_limits<T>::epsilon();
+		const size_t maxIterations = 30 * n + 30;
+		T f(0), tst1(0);
+		for (size_t l = 0; l < n; l++)
+		{
+			tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+			size_t m = l;
+			while (m < n - 1 && std::abs(e[m]) > eps * tst1)
+			{
+				m++;
+			}
+			if (m > l)
+			{
+				size_t iterations = 0;
+				do
+				{
+					if (++iterations > maxIterations)
+					{
+						throw std::runtime_error("Symmetric eigensolver did not converge!");
+					}
+					T g = d[l];
+					T p = (d[l + 1] - g) / (T(2) * e[l]);
+					T r = std::hypot(p, T(1));
+					if (p < T(0))
+					{
+						r = -r;
+					}
+					d[l] = e[l] / (p + r);
+					d[l + 1] = e[l] * (p + r);
+					T dl1 = d[l + 1];
+					T h = g - d[l];
+					for (size_t i = l + 2; i < n; i++)
+					{
+						d[i] -= h;
+					}
+					f += h;
+
+					p = d[m];
+					T c(1), c2(1), c3(1), s(0), s2(0);
+					T el1 = e[l + 1];
+					for (size_t i = m; i-- > l;)
+					{
+						c3 = c2;
+						c2 = c;
+						s2 = s;
+						g = c * e[i];
+						h = c * p;
+						r = std::hypot(p, e[i]);
+						e[i + 1] = s * r;
+						s = e[i] / r;
+						c = p / r;
+						p = c * d[i] - s * g;
+						d[i + 1] = h + s * (c * g + s * d[i]);
+						if (computeVectors)
+						{
+							for (size_t k = 0; k < n; k++)
+							{
+								h = V(k, i + 1);
+								V(k, i + 1) = s * V(k, i) + c * h;
+								V(k, i) = c * V(k, i) - s * h;
+							}
+						}
+					}
+					p = -s * s2 * c3 * el1 * e[l] / dl1;
+					e[l] = s * p;
+					d[l] = c * p;
+				} while (std::abs(e[l]) > eps * tst1);
+			}
+			d[l] += f;
+			e[l] = T(0);
+		}
+
+		std::vector<size_t> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return d[a] > d[b]; });
+		for (size_t i : order)
+		{
+			result.values.push_back(d[i]);
+		}
+		if (computeVectors)
+		{
+			result.vectors = detail::selectColumns(vectors, order);
+		}
+		return result;
+	}
+
+	template <typename T>
+	SingularValueDecomposition<T> svd(const Matrix<T>& A) noexcept(false)
+	{
+		detail::checkFloatingPoint<T>();
+#ifdef MATRIX_HAS_LAPACKE
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			if (detail::useLapack<T>() && !A.empty())
+			{
+				return detail::lapackSVD(A);
+			}
+		}
+#endif
+		if (A.getCountRows() < A.getCountColumns())
+		{
+			SingularValueDecomposition<T> t = svd(A.transposed());
+			return { t.V, t.S, t.U };
+		}
+		const size_t m = A.getCountRows(), n = A.getCountColumns();
+		//columns of A and V are kept as rows so that rotations touch contiguous memory
+		Matrix<T> Ut = A.transposed();
+		Matrix<T> Vt = identity<T>(n);
+		T* const u = Ut.data();
+		T* const v = Vt.data();
+		const T eps = std::numeric_limits<T>::epsilon();
+		const size_t maxSweeps = 60;
+		bool rotated = n > 1;
+		for (size_t sweep = 0; rotated; sweep++)
+		{
+			if (sweep == maxSweeps)
+			{
+				throw std::runtime_error("Jacobi SVD did not converge!");
+			}
+			rotated = false;
+			for (size_t p = 0; p + 1 < n; p++)
+			{
+				for (size_t q = p + 1; q < n; q++)
+				{
+					T alpha = detail::rowDot(Ut, p, Ut, p);
+					T beta = detail::rowDot(Ut, q, Ut, q);
+					T gamma = detail::rowDot(Ut, p, Ut, q);
+					if (gamma == T(0) || std::abs(gamma) <= eps * std::sqrt(alpha * beta))
+					{
+						continue;
+					}
+					rotated = true;
+					T zeta = (beta - alpha) / (T(2) * gamma);
+					T t = (zeta < T(0) ? T(-1) : T(1)) / (std::abs(zeta) + std::hypot(T(1), zeta));
+					T c = T(1) / std::hypot(T(1), t);
+					T s = c * t;
+					for (size_t i = 0; i < m; i++)
+					{
+						T up = u[p * m + i], uq = u[q * m + i];
+						u[p * m + i] = c * up - s * uq;
+						u[q * m + i] = s * up + c * uq;
+					}
+					for (size_t i = 0; i < n; i++)
+					{
+						T vp = v[p * n + i], vq = v[q * n + i];
+						v[p * n + i] = c * vp - s * vq;
+						v[q * n + i] = s * vp + c * vq;
+					}
+				}
+			}
+		}
+		std::vector<T> sigma(n);
+		for (size_t j = 0; j < n; j++)
+		{
+			sigma[j] = std::sqrt(detail::rowDot(Ut, j, Ut, j));
+			for (size_t i = 0; i < m; i++)
+			{
+				u[j * m + i] = sigma[j] > T(0) ? u[j * m + i] / sigma[j] : T(0);
+			}
+		}
+		std::vector<size_t> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sigma[a] > sigma[b]; });
+		SingularValueDecomposition<T> result;
+		for (size_t j : order)
+		{
+			result.S.push_back(sigma[j]);
+		}
+		result.U = detail::selectColumns(Ut.transposed(), order);
+		result.V = detail::selectColumns(Vt.transposed(), order);
+		return result;
+	}
+
+	template <typename T>
+	EigenDecomposition<T> powerIteration(const Matrix<T>& A, size_t k, size_t maxIterations, T tolerance, std::uint64_t seed) noexcept(false)
+	{
+		detail::checkFloatingPoint<T>();
+		if (A.getCountRows() != A.getCountColumns())
+		{
+			throw std::domain_error("Power iteration is undefined for non square matrix!");
+		}
+		const size_t n = A.getCountRows();
+		if (k == 0 || k > n)
+		{
+			throw std::invalid_argument("Number of requested eigenpairs has to be between 1 and the dimension of the matrix!");
+		}
+		//basis of the iterated subspace stored as rows
+		Matrix<T> Qt = normal<T>(k, n, T(0), T(1), seed);
+		detail::orthonormalizeRows(Qt);
+		std::vector<T> previous(k, T(0));
+		for (size_t iteration = 0; iteration < maxIterations; iteration++)
+		{
+			//A is symmetric, so (A * Q)^T = Q^T * A
+			Matrix<T> Zt = Qt * A;
+			std::vector<T> ritz = symmetricEigen(Zt * Qt.transposed(), false).values;
+			std::sort(ritz.begin(), ritz.end(), [](const T& a, const T& b) { return std::abs(a) > std::abs(b); });
+			T change(0), scale(0);
+			for (size_t i = 0; i < k; i++)
+			{
+				change = std::max(change, std::abs(ritz[i] - previous[i]));
+				scale = std::max(scale, std::abs(ritz[i]));
+			}
+			previous = ritz;
+			detail::orthonormalizeRows(Zt);
+			Qt = Zt;
+			if (change <= tolerance * scale)
+			{
+				break;
+			}
+		}
+		//Rayleigh-Ritz projection onto the converged subspace
+		EigenDecomposition<T> small = symmetricEigen(Qt * A * Qt.transposed());
+		EigenDecomposition<T> result = detail::dominantPairs(small, k);
+		result.vectors = Qt.transposed() * result.vectors;
+		return result;
+	}
+
+	template <typename T>
+	EigenDecomposition<T> lanczos(const Matrix<T>& A, size_t k, size_t steps, std::uint64_t seed) noexcept(false)
+	{
+		detail::checkFloatingPoint<T>();
+		if (A.getCountRows() != A.getCountColumns())
+		{
+			throw std::domain_error("Lanczos iteration is undefined for non square matrix!");
+		}
+		const size_t n = A.getCountRows();
+		if (k == 0 || k > n)
+		{
+			throw std::invalid_argument("Number of requested eigenpairs has to be between 1 and the dimension of the matrix!");
+		}
+		const size_t m = std::min(n, steps == 0 ? 2 * k + 20 : std::max(steps, k));
+		//Lanczos vectors stored as rows, the extra row holds the next candidate
+		Matrix<T> Qt(m + 1, n);
+		Matrix<T> Tm(m, m);
+		T* const q = Qt.data();
+		//number of random vectors drawn so far, each restart draws from its own Philox stream
+		std::uint64_t draws = 0;
+		auto restart = [&](size_t j)
+		{
+			//starts a fresh Krylov sequence orthogonal to everything built so far
+			do
+			{
+				Matrix<T> candidate(j + 1, n, Uninitialized);
+				std::copy_n(q, j * n, candidate.data());
+				const Matrix<T> start = normal<T>(1, n, T(0), T(1), seed + draws++);
+				std::copy_n(start.data(), n, candidate.data() + j * n);
+				detail::orthonormalizeRows(candidate);
+				std::copy_n(std::as_const(candidate).data() + j * n, n, q + j * n);
+			} while (detail::rowDot(Qt, j, Qt, j) == T(0));
+		};
+		restart(0);
+		std::vector<T> current(n), w(n);
+		for (size_t j = 0; j < m; j++)
+		{
+			std::copy_n(q + j * n, n, current.begin());
+			gemv(T(1), A, Transpose::No, current, T(0), w);
+			//full reorthogonalization against all previous Lanczos vectors (twice is enough)
+			for (int pass = 0; pass < 2; pass++)
+			{
+				for (size_t i = 0; i <= j; i++)
+				{
+					const T* row = q + i * n;
+					T projection(0);
+					for (size_t c = 0; c < n; c++)
+					{
+						projection += w[c] * row[c];
+					}
+					if (pass == 0 && i == j)
+					{
+						Tm(j, j) = projection;
+					}
+					for (size_t c = 0; c < n; c++)
+					{
+						w[c] -= projection * row[c];
+					}
+				}
+			}
+			if (j + 1 == m)
+			{
+				break;
+			}
+			T beta(0);
+			for (const T& value : w)
+			{
+				beta += value * value;
+			}
+			beta = std::sqrt(beta);
+			if (beta <= std::numeric_limits<T>::epsilon() * std::max(std::abs(Tm(j, j)), T(1)))
+			{
+				//invariant subspace found, the tridiagonal matrix decouples
+				restart(j + 1);
+				continue;
+			}
+			Tm(j, j + 1) = beta;
+			Tm(j + 1, j) = beta;
+			for (size_t c = 0; c < n; c++)
+			{
+				q[(j + 1) * n + c] = w[c] / beta;
+			}
+		}
+		EigenDecomposition<T> result = detail::dominantPairs(symmetricEigen(Tm), k);
+		Matrix<T> basis(m, n, std::span<const T>(q, m * n));
+		result.vectors = basis.transposed() * result.vectors;
+		return result;
+	}
+
+	template <typename T>
+	SingularValueDecomposition<T> randomizedSVD(const Matrix<T>& A, size_t k, size_t oversampling, size_t powerIterations, std::uint64_t seed) noexcept(false)
+	{
+		detail::checkFloatingPoint<T>();
+		const size_t m = A.getCountRows(), n = A.getCountColumns();
+		if (k == 0 || k > std::min(m, n))
+		{
+			throw std::invalid_argument("Number of requested singular triplets has to be between 1 and the smaller dimension of the matrix!");
+		}
+		const size_t l = std::min(k + oversampling, std::min(m, n));
+		//orthonormal basis of the sampled range of A, stored as rows
+		Matrix<T> Qt = (A * normal<T>(n, l, T(0), T(1), seed)).transposed();
+		detail::orthonormalizeRows(Qt);
+		for (size_t q = 0; q < powerIterations; q++)
+		{
+			Matrix<T> Zt = Qt * A;
+			detail::orthonormalizeRows(Zt);
+			Qt = (A * Zt.transposed()).transposed();
+			detail::orthonormalizeRows(Qt);
+		}
+		SingularValueDecomposition<T> small = svd(Qt * A);
+		std::vector<size_t> leading(k);
+		std::iota(leading.begin(), leading.end(), 0);
+		SingularValueDecomposition<T> result;
+		result.S.assign(small.S.begin(), small.S.begin() + k);
+		result.U = Qt.transposed() * detail::selectColumns(small.U, leading);
+		result.V = detail::selectColumns(small.V, leading);
+		return result;
+	}
+}
@@ -0,0 +1,215 @@
+#pragma once
+#include "Matrix.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	//counter-based Philox4x32-10 generator, the output is a pure function of key and counter
+	//so any block of random numbers can be produced independently of all the others
+	class Philox4x32
+	{
+		std::array<std::uint32_t, 2> key;
+
+	public:
+		typedef std::array<std::uint32_t, 4> Counter;
+
+		explicit Philox4x32(std::uint64_t seed) noexcept : key{ std::uint32_t(seed), std::uint32_t(seed >> 32) } {}
+
+		Counter operator()(Counter counter) const noexcept
+		{
+			std::uint32_t k0 = key[0], k1 = key[1];
+			for (int round = 0; round < 10; round++)
+			{
+				const std::uint64_t p0 = std::uint64_t(0xD2511F53u) * counter[0];
+				const std::uint64_t p1 = std::uint64_t(0xCD9E8D57u) * counter[2];
+				counter = { std::uint32_t(p1 >> 32) ^ counter[1] ^ k0, std::uint32_t(p1), std::uint32_t(p0 >> 32) ^ counter[3] ^ k1, std::uint32_t(p0) };
+				k0 += 0x9E3779B9u;
+				k1 += 0xBB67AE85u;
+			}
+			return counter;
+		}
+
+		//two 64-bit words of the given block
+		std::array<std::uint64_t, 2> block(std::uint64_t index) const noexcept
+		{
+			const Counter c = (*this)({ std::uint32_t(index), std::uint32_t(index >> 32), 0, 0 });
+			return { (std::uint64_t(c[0]) << 32) | c[1], (std::uint64_t(c[2]) << 32) | c[3] };
+		}
+	};
+
+	//the fills below run on the shared thread pool; the random ones draw field k of the row-major
+	//order from block k/2 of Philox4x32 keyed by the seed, so the result does not depend on the number of threads
+
+	//M x N matrix of values uniformly distributed in [low, high)
+	template <typename T>
+	Matrix<T> uniform(const size_t& M, const size_t& N, const T& low, const T& high, std::uint64_t seed) noexcept(false);
+
+	//M x N matrix of normally distributed values
+	template <typename T>
+	Matrix<T> normal(const size_t& M, const size_t& N, const T& mean, const T& deviation, std::uint64_t seed) noexcept(false);
+
+	//N x N identity matrix
+	template <typename T>
+	Matrix<T> identity(const size_t& N);
+
+	//square matrix with the given values on the diagonal
+	template <typename T>
+	Matrix<T> diagonal(const std::vector<T>& values);
+
+	//M x N matrix with every field equal to value
+	template <typename T>
+	Matrix<T> constant(const size_t& M, const size_t& N, const T& value);
+
+	//M x N matrix of start, start+step, start+2*step, ... stored row after row
+	template <typename T>
+	Matrix<T> arange(const size_t& M, const size_t& N, const T& start = T(0), const T& step = T(1));
+
+	namespace detail
+	{
+		//number of fields one chunk of a parallel fill writes
+		constexpr size_t FillGrain = 1 << 14;
+
+		//M x N matrix built by calling body(i, row) for every row in parallel, row pointing at its first field;
+		//the filled buffer is adopted by the matrix, so its copies share it
+		template <typename T, typename F>
+		Matrix<T> fillRows(const size_t& M, const size_t& N, F body)
+		{
+			typename Matrix<T>::Storage fields(M * N);
+			const size_t grain = std::max<size_t>(1, FillGrain / std::max<size_t>(1, N));
+			ThreadPool::shared().parallelFor(0, M, grain, [&](size_t first, size_t last)
+			{
+				for (size_t i = first; i < last; i++)
+				{
+					body(i, fields.data() + i * N);
+				}
+			});
+			return Matrix<T>(M, N, std::move(fields));
+		}
+
+		//maps the top bits of a word to [0, 1)
+		template <typename T>
+		T unit(std::uint64_t word) noexcept
+		{
+			constexpr int bits = std::min(std::numeric_limits<T>::digits, 64);
+			return T(word >> (64 - bits)) * (T(1) / T(std::uint64_t(1) << (bits - 1)) / T(2));
+		}
+
+		//M x N matrix filled from Philox blocks, transform(words, count, out) turns 2*count random words
+		//into 2*count fields; blocks are generated in batches first so the transform vectorizes
+		template <typename T, typename Transform>
+		Matrix<T> fillRandom(const size_t& M, const size_t& N, std::uint64_t seed, Transform transform)
+		{
+			const Philox4x32 generator(seed);
+			const size_t total = M * N;
+			typename Matrix<T>::Storage buffer(total);
+			T* fields = buffer.data();
+			constexpr size_t Batch = 64;
+			ThreadPool::shared().parallelFor(0, (total + 1) / 2, FillGrain / 2, [&](size_t first, size_t last)
+			{
+				std::uint64_t words[2 * Batch];
+				T values[2 * Batch];
+				for (size_t b0 = first; b0 < last; b0 += Batch)
+				{
+					const size_t count = std::min(Batch, last - b0);
+					for (size_t b = 0; b < count; b++)
+					{
+						const std::array<std::uint64_t, 2> w = generator.block(b0 + b);
+						words[2 * b] = w[0];
+						words[2 * b + 1] = w[1];
+					}
+					transform(words, count, values);
+					std::copy_n(values, std::min(2 * count, total - 2 * b0), fields + 2 * b0);
+				}
+			});
+			return Matrix<T>(M, N, std::move(buffer));
+		}
+	}
+
+	template <typename T>
+	Matrix<T> uniform(const size_t& M, const size_t& N, const T& low, const T& high, std::uint64_t seed) noexcept(false)
+	{
+		static_assert(std::is_floating_point_v<T>, "Random fills require a floating point element type!");
+		if (!(low < high))
+		{
+			throw std::invalid_argument("Lower bound has to be less than the upper bound!");
+		}
+		const T width = high - low, top = std::nextafter(high, low);
+		return detail::fillRandom<T>(M, N, seed, [&](const std::uint64_t* words, size_t count, T* out)
+		{
+			for (size_t i = 0; i < 2 * count; i++)
+			{
+				out[i] = std::min(low + width * detail::unit<T>(words[i]), top);
+			}
+		});
+	}
+
+	template <typename T>
+	Matrix<T> normal(const size_t& M, const size_t& N, const T& mean, const T& deviation, std::uint64_t seed) noexcept(false)
+	{
+		static_assert(std::is_floating_point_v<T>, "Random fills require a floating point element type!");
+		if (!(deviation >= T(0)))
+		{
+			throw std::invalid_argument("Standard deviation has to be non-negative!");
+		}
+		//Box-Muller, both words of a block give one pair of independent normals
+		return detail::fillRandom<T>(M, N, seed, [&](const std::uint64_t* words, size_t count, T* out)
+		{
+			for (size_t b = 0; b < count; b++)
+			{
+				const T radius = deviation * std::sqrt(T(-2) * std::log(T(1) - detail::unit<T>(words[2 * b])));
+				const T angle = T(2) * std::numbers::pi_v<T> * detail::unit<T>(words[2 * b + 1]);
+				out[2 * b] = mean + radius * std::cos(angle);
+				out[2 * b + 1] = mean + radius * std::sin(angle);
+			}
+		});
+	}
+
+	template <typename T>
+	Matrix<T> identity(const size_t& N)
+	{
+		return detail::fillRows<T>(N, N, [N](size_t i, T* row)
+		{
+			std::fill_n(row, N, T(0));
+			row[i] = T(1);
+		});
+	}
+
+	template <typename T>
+	Matrix<T> diagonal(const std::vector<T>& values)
+	{
+		const size_t N = values.size();
+		return detail::fillRows<T>(N, N, [&](size_t i, T* row)
+		{
+			std::fill_n(row, N, T(0));
+			row[i] = values[i];
+		});
+	}
+
+	template <typename T>
+	Matrix<T> constant(const size_t& M, const size_t& N, const T& value)
+	{
+		return detail::fillRows<T>(M, N, [&](size_t, T* row) { std::fill_n(row, N, value); });
+	}
+
+	template <typename T>
+	Matrix<T> arange(const size_t& M, const size_t& N, const T& start, const T& step)
+	{
+		//every field is computed from its index, not accumulated, so chunks agree with a serial fill
+		return detail::fillRows<T>(M, N, [&](size_t i, T* row)
+		{
+			for (size_t j = 0; j < N; j++)
+			{
+				row[j] = T(start + T(i * N + j) * step);
+			}
+		});
+	}
+}
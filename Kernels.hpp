@@ -0,0 +1,323 @@
+#pragma once
+#include "Arithmetic.hpp"
+#include "Backend.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	enum class Transpose { No, Yes };
+
+	enum class Triangle { Upper, Lower };
+
+	namespace detail
+	{
+		//block sizes of the packed kernels: rows of C per task, depth of one pass and width of a packed panel of B
+		constexpr size_t RowBlock = 64;
+		constexpr size_t DepthBlock = 128;
+		constexpr size_t ColumnBlock = 256;
+
+		//products with fewer multiply-adds than this are not worth spreading over the pool
+		constexpr size_t ParallelThreshold = 1 << 18;
+
+		//part of C updated by a panel
+		enum class Part { All, Lower, Upper };
+
+		//C[i0:i1, j0:j1] = beta*C + alpha*op(A)[i0:i1, :]*op(B)[:, j0:j1] on row-major buffers with given strides,
+		//restricted to one triangle of C if asked; beta == 0 does not read C
+		template <typename T>
+		void gemmPanel(size_t i0, size_t i1, size_t j0, size_t j1, size_t k, const T& alpha, const T* A, size_t lda, bool transA, const T* B, size_t ldb, bool transB, const T& beta, T* C, size_t ldc, Part part)
+		{
+			auto columnsOf = [&](size_t i, size_t lo, size_t hi, size_t& first, size_t& last)
+			{
+				first = part == Part::Upper ? std::max(lo, i) : lo;
+				last = part == Part::Lower ? std::min(hi, i + 1) : hi;
+				return first < last;
+			};
+			for (size_t i = i0; i < i1; i++)
+			{
+				size_t first, last;
+				if (!columnsOf(i, j0, j1, first, last))
+				{
+					continue;
+				}
+				T* c = C + i * ldc;
+				for (size_t j = first; j < last; j++)
+				{
+					c[j] = beta == T(0) ? T(0) : T(beta * c[j]);
+				}
+			}
+			if (alpha == T(0) || k == 0)
+			{
+				return;
+			}
+			std::vector<T> packedA((i1 - i0) * std::min(k, DepthBlock));
+			std::vector<T> packedB(std::min(k, DepthBlock) * std::min(j1 - j0, ColumnBlock));
+			for (size_t p0 = 0; p0 < k; p0 += DepthBlock)
+			{
+				const size_t p1 = std::min(k, p0 + DepthBlock), depth = p1 - p0;
+				for (size_t i = i0; i < i1; i++)
+				{
+					for (size_t p = p0; p < p1; p++)
+					{
+						packedA[(i - i0) * depth + (p - p0)] = alpha * (transA ? A[p * lda + i] : A[i * lda + p]);
+					}
+				}
+				for (size_t jb = j0; jb < j1; jb += ColumnBlock)
+				{
+					const size_t jb1 = std::min(j1, jb + ColumnBlock), width = jb1 - jb;
+					if ((part == Part::Lower && jb >= i1) || (part == Part::Upper && jb1 <= i0))
+					{
+						continue;
+					}
+					for (size_t p = p0; p < p1; p++)
+					{
+						T* b = packedB.data() + (p - p0) * width;
+						for (size_t j = jb; j < jb1; j++)
+						{
+							b[j - jb] = transB ? B[j * ldb + p] : B[p * ldb + j];
+						}
+					}
+					for (size_t i = i0; i < i1; i++)
+					{
+						size_t first, last;
+						if (!columnsOf(i, jb, jb1, first, last))
+						{
+							continue;
+						}
+						T* c = C + i * ldc;
+						const T* a = packedA.data() + (i - i0) * depth;
+						for (size_t p = 0; p < depth; p++)
+						{
+							const T factor = a[p];
+							const T* b = packedB.data() + p * width;
+							for (size_t j = first; j < last; j++)
+							{
+								c[j] += factor * b[j - jb];
+							}
+						}
+					}
+				}
+			}
+		}
+
+		//exact variant of gemmPanel for integer fields, products and sums are formed in the widest integer type
+		//with overflow checks, so the result is either exact or std::overflow_error is thrown
+		template <typename T>
+		void integerPanel(size_t i0, size_t i1, size_t j0, size_t j1, size_t k, const T& alpha, const T* A, size_t lda, bool transA, const T* B, size_t ldb, bool transB, const T& beta, T* C, size_t ldc, Part part)
+		{
+			typedef Widened<T> W;
+			std::vector<W> row(j1 - j0);
+			for (size_t i = i0; i < i1; i++)
+			{
+				const size_t first = part == Part::Upper ? std::max(j0, i) : j0;
+				const size_t last = part == Part::Lower ? std::min(j1, i + 1) : j1;
+				if (first >= last)
+				{
+					continue;
+				}
+				std::fill(row.begin(), row.end(), W(0));
+				for (size_t p = 0; p < k && alpha != T(0); p++)
+				{
+					const T a = transA ? A[p * lda + i] : A[i * lda + p];
+					if (a == T(0))
+					{
+						continue;
+					}
+					const W factor = checkedMul(W(alpha), W(a));
+					for (size_t j = first; j < last; j++)
+					{
+						row[j - j0] = checkedAdd(row[j - j0], checkedMul(factor, W(transB ? B[j * ldb + p] : B[p * ldb + j])));
+					}
+				}
+				T* c = C + i * ldc;
+				for (size_t j = first; j < last; j++)
+				{
+					W value = row[j - j0];
+					if (beta != T(0))
+					{
+						value = checkedAdd(value, checkedMul(W(beta), W(c[j])));
+					}
+					c[j] = narrow<T>(value);
+				}
+			}
+		}
+
+		//picks the exact integer panel or the packed floating point one
+		template <typename T>
+		void panel(size_t i0, size_t i1, size_t j0, size_t j1, size_t k, const T& alpha, const T* A, size_t lda, bool transA, const T* B, size_t ldb, bool transB, const T& beta, T* C, size_t ldc, Part part)
+		{
+			if constexpr (isExactInteger<T>)
+			{
+				integerPanel(i0, i1, j0, j1, k, alpha, A, lda, transA, B, ldb, transB, beta, C, ldc, part);
+			}
+			else
+			{
+				gemmPanel(i0, i1, j0, j1, k, alpha, A, lda, transA, B, ldb, transB, beta, C, ldc, part);
+			}
+		}
+
+#ifdef MATRIX_HAS_CBLAS
+		inline void blasGemm(size_t m, size_t n, size_t k, const float& alpha, const float* A, size_t lda, bool transA, const float* B, size_t ldb, bool transB, const float& beta, float* C, size_t ldc)
+		{
+			cblas_sgemm(CblasRowMajor, transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans, int(m), int(n), int(k), alpha, A, int(lda), B, int(ldb), beta, C, int(ldc));
+		}
+
+		inline void blasGemm(size_t m, size_t n, size_t k, const double& alpha, const double* A, size_t lda, bool transA, const double* B, size_t ldb, bool transB, const double& beta, double* C, size_t ldc)
+		{
+			cblas_dgemm(CblasRowMajor, transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans, int(m), int(n), int(k), alpha, A, int(lda), B, int(ldb), beta, C, int(ldc));
+		}
+
+		inline void blasGemv(size_t m, size_t n, const float& alpha, const float* A, size_t lda, bool transA, const float* x, const float& beta, float* y)
+		{
+			cblas_sgemv(CblasRowMajor, transA ? CblasTrans : CblasNoTrans, int(m), int(n), alpha, A, int(lda), x, 1, beta, y, 1);
+		}
+
+		inline void blasGemv(size_t m, size_t n, const double& alpha, const double* A, size_t lda, bool transA, const double* x, const double& beta, double* y)
+		{
+			cblas_dgemv(CblasRowMajor, transA ? CblasTrans : CblasNoTrans, int(m), int(n), alpha, A, int(lda), x, 1, beta, y, 1);
+		}
+
+		inline void blasSyrk(bool lower, size_t n, size_t k, const float& alpha, const float* A, size_t lda, bool transA, const float& beta, float* C, size_t ldc)
+		{
+			cblas_ssyrk(CblasRowMajor, lower ? CblasLower : CblasUpper, transA ? CblasTrans : CblasNoTrans, int(n), int(k), alpha, A, int(lda), beta, C, int(ldc));
+		}
+
+		inline void blasSyrk(bool lower, size_t n, size_t k, const double& alpha, const double* A, size_t lda, bool transA, const double& beta, double* C, size_t ldc)
+		{
+			cblas_dsyrk(CblasRowMajor, lower ? CblasLower : CblasUpper, transA ? CblasTrans : CblasNoTrans, int(n), int(k), alpha, A, int(lda), beta, C, int(ldc));
+		}
+#endif
+
+		//C (m x n) = alpha*op(A)*op(B) + beta*C, row blocks of C are computed in parallel
+		template <typename T>
+		void gemm(size_t m, size_t n, size_t k, const T& alpha, const T* A, size_t lda, bool transA, const T* B, size_t ldb, bool transB, const T& beta, T* C, size_t ldc)
+		{
+#ifdef MATRIX_HAS_CBLAS
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			{
+				if (useBlas<T>() && m && n && k)
+				{
+					blasGemm(m, n, k, alpha, A, lda, transA, B, ldb, transB, beta, C, ldc);
+					return;
+				}
+			}
+#endif
+			const size_t blocks = (m + RowBlock - 1) / RowBlock;
+			auto body = [&](size_t first, size_t last)
+			{
+				for (size_t block = first; block < last; block++)
+				{
+					panel(block * RowBlock, std::min(m, (block + 1) * RowBlock), 0, n, k, alpha, A, lda, transA, B, ldb, transB, beta, C, ldc, Part::All);
+				}
+			};
+			if (m * n * k < ParallelThreshold)
+			{
+				body(0, blocks);
+				return;
+			}
+			ThreadPool::shared().parallelFor(0, blocks, 1, body);
+		}
+
+		//y = alpha*op(A)*x + beta*y for m x n matrix A, blocks of y are computed in parallel
+		template <typename T>
+		void gemv(size_t m, size_t n, const T& alpha, const T* A, size_t lda, bool transA, const T* x, const T& beta, T* y)
+		{
+			const size_t length = transA ? n : m;
+#ifdef MATRIX_HAS_CBLAS
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			{
+				if (useBlas<T>() && m && n)
+				{
+					blasGemv(m, n, alpha, A, lda, transA, x, beta, y);
+					return;
+				}
+			}
+#endif
+			if constexpr (isExactInteger<T>)
+			{
+				//x and y are single column matrices
+				panel(0, length, 0, 1, transA ? m : n, alpha, A, lda, transA, x, 1, false, beta, y, 1, Part::All);
+			}
+			else
+			{
+				auto body = [&](size_t first, size_t last)
+				{
+					const size_t i0 = first * RowBlock, i1 = std::min(length, last * RowBlock);
+					for (size_t i = i0; i < i1; i++)
+					{
+						y[i] = beta == T(0) ? T(0) : T(beta * y[i]);
+					}
+					if (alpha == T(0))
+					{
+						return;
+					}
+					if (!transA)
+					{
+						for (size_t i = i0; i < i1; i++)
+						{
+							const T* a = A + i * lda;
+							T s(0);
+							for (size_t j = 0; j < n; j++)
+							{
+								s += a[j] * x[j];
+							}
+							y[i] += alpha * s;
+						}
+						return;
+					}
+					//every block owns its range of y and streams through the matching columns of A
+					for (size_t r = 0; r < m; r++)
+					{
+						const T factor = alpha * x[r];
+						const T* a = A + r * lda;
+						for (size_t i = i0; i < i1; i++)
+						{
+							y[i] += factor * a[i];
+						}
+					}
+				};
+				const size_t blocks = (length + RowBlock - 1) / RowBlock;
+				if (m * n < ParallelThreshold)
+				{
+					body(0, blocks);
+					return;
+				}
+				ThreadPool::shared().parallelFor(0, blocks, 1, body);
+			}
+		}
+
+		//one triangle of C (n x n) = alpha*op(A)*op(A)^T + beta*C, op(A) is n x k, the other triangle is untouched
+		template <typename T>
+		void syrk(bool lower, size_t n, size_t k, const T& alpha, const T* A, size_t lda, bool transA, const T& beta, T* C, size_t ldc)
+		{
+#ifdef MATRIX_HAS_CBLAS
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			{
+				if (useBlas<T>() && n && k)
+				{
+					blasSyrk(lower, n, k, alpha, A, lda, transA, beta, C, ldc);
+					return;
+				}
+			}
+#endif
+			const size_t blocks = (n + RowBlock - 1) / RowBlock;
+			auto body = [&](size_t first, size_t last)
+			{
+				for (size_t block = first; block < last; block++)
+				{
+					const size_t i0 = block * RowBlock, i1 = std::min(n, i0 + RowBlock);
+					panel(i0, i1, lower ? 0 : i0, lower ? i1 : n, k, alpha, A, lda, transA, A, lda, !transA, beta, C, ldc, lower ? Part::Lower : Part::Upper);
+				}
+			};
+			if (n * n * k / 2 < ParallelThreshold)
+			{
+				body(0, blocks);
+				return;
+			}
+			ThreadPool::shared().parallelFor(0, blocks, 1, body);
+		}
+	}
+}
@@ -0,0 +1,721 @@
+#pragma once
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	//stopping criteria of the iterative solvers, iteration stops once ||b - A*x|| <= tolerance*||b||
+	template <typename T>
+	struct SolverOptions
+	{
+		T tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+		size_t maxIterations = 1000;
+		//size of the Krylov basis kept by gmres before it restarts
+		size_t restart = 30;
+	};
+
+	//outcome of an iterative solve, residual is the relative residual ||b - A*x||/||b||
+	template <typename T>
+	struct SolverResult
+	{
+		size_t iterations = 0;
+		T residual = T(0);
+		bool converged = false;
+	};
+
+	//linear operator applied matrix-free as A(x, y) computing y = A*x, y already has the length of x
+	template <typename Op, typename T>
+	concept LinearOperator = std::invocable<const Op&, const std::vector<T>&, std::vector<T>&>;
+
+	//square sparse matrix in compressed sparse rows, columns of each row sorted ascending;
+	//it is a linear operator, so the iterative solvers take it directly
+	template <typename T>
+	class SparseMatrix
+	{
+		std::vector<size_t> rowStart, column;
+		std::vector<T> values;
+
+	public:
+		//constructor from compressed sparse rows, row i keeps the fields rowStart[i]..rowStart[i+1]-1
+		SparseMatrix(std::vector<size_t> RowStart, std::vector<size_t> Column, std::vector<T> Values) noexcept(false);
+
+		//constructor keeping the nonzero fields of a square matrix
+		explicit SparseMatrix(const Matrix<T>& A) noexcept(false);
+
+		size_t getCountRows() const noexcept { return rowStart.size() - 1; }
+		size_t getCountColumns() const noexcept { return rowStart.size() - 1; }
+		size_t getCountNonZeros() const noexcept { return values.size(); }
+		const std::vector<size_t>& getRowStart() const noexcept { return rowStart; }
+		const std::vector<size_t>& getColumnIndices() const noexcept { return column; }
+		const std::vector<T>& getValues() const noexcept { return values; }
+
+		//y = A*x with blocks of rows spread over the shared thread pool, x and y have to be different vectors
+		void operator()(const std::vector<T>& x, std::vector<T>& y) const noexcept(false);
+
+		Matrix<T> toMatrix() const;
+	};
+
+	//preconditioners are applied the same way, M(r, z) computes z = M^-1*r
+
+	//no preconditioning, z = r
+	template <typename T>
+	struct IdentityPreconditioner
+	{
+		void operator()(const std::vector<T>& r, std::vector<T>& z) const { z = r; }
+	};
+
+	//diagonal scaling z = D^-1*r
+	template <typename T>
+	class JacobiPreconditioner
+	{
+		std::vector<T> inverse;
+
+	public:
+		//constructor from the diagonal of a matrix-free operator
+		explicit JacobiPreconditioner(const std::vector<T>& Diagonal) noexcept(false);
+
+		//constructor from the diagonal of a square matrix
+		explicit JacobiPreconditioner(const Matrix<T>& A) noexcept(false);
+
+		void operator()(const std::vector<T>& r, std::vector<T>& z) const;
+	};
+
+	//incomplete LU factorization without fill-in, L and U keep the sparsity pattern of A
+	//and are stored together in compressed sparse rows with the unit diagonal of L implicit
+	template <typename T>
+	class ILU0Preconditioner
+	{
+		std::vector<size_t> rowStart, column, diagonal;
+		std::vector<T> values;
+
+		void factorize() noexcept(false);
+
+	public:
+		//constructor from a sparse matrix, the factors take over its sparsity pattern
+		explicit ILU0Preconditioner(const SparseMatrix<T>& A) noexcept(false);
+
+		//constructor from a matrix in compressed sparse rows, columns of each row sorted ascending
+		ILU0Preconditioner(std::vector<size_t> RowStart, std::vector<size_t> Column, std::vector<T> Values) noexcept(false);
+
+		//constructor treating the nonzero fields of a square matrix as its sparsity pattern
+		explicit ILU0Preconditioner(const Matrix<T>& A) noexcept(false);
+
+		void operator()(const std::vector<T>& r, std::vector<T>& z) const;
+	};
+
+	//solvers on a linear operator, a SparseMatrix runs its products on the parallel SpMV
+
+	//preconditioned conjugate gradients for symmetric positive definite A and M,
+	//x holds the initial guess (empty meaning zero) and receives the solution
+	template <typename T, typename Op, typename Pre = IdentityPreconditioner<T>>
+		requires LinearOperator<Op, T>
+	SolverResult<T> cg(const Op& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M = Pre(), const SolverOptions<T>& options = SolverOptions<T>()) noexcept(false);
+
+	//restarted GMRES with right preconditioning for general nonsingular A
+	template <typename T, typename Op, typename Pre = IdentityPreconditioner<T>>
+		requires LinearOperator<Op, T>
+	SolverResult<T> gmres(const Op& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M = Pre(), const SolverOptions<T>& options = SolverOptions<T>()) noexcept(false);
+
+	//BiCGSTAB with right preconditioning for general nonsingular A
+	template <typename T, typename Op, typename Pre = IdentityPreconditioner<T>>
+		requires LinearOperator<Op, T>
+	SolverResult<T> bicgstab(const Op& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M = Pre(), const SolverOptions<T>& options = SolverOptions<T>()) noexcept(false);
+
+	//overloads on a dense matrix, its products run on the parallel gemv kernel
+	template <typename T, typename Pre = IdentityPreconditioner<T>>
+	SolverResult<T> cg(const Matrix<T>& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M = Pre(), const SolverOptions<T>& options = SolverOptions<T>()) noexcept(false);
+
+	template <typename T, typename Pre = IdentityPreconditioner<T>>
+	SolverResult<T> gmres(const Matrix<T>& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M = Pre(), const SolverOptions<T>& options = SolverOptions<T>()) noexcept(false);
+
+	template <typename T, typename Pre = IdentityPreconditioner<T>>
+	SolverResult<T> bicgstab(const Matrix<T>& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M = Pre(), const SolverOptions<T>& options = SolverOptions<T>()) noexcept(false);
+
+	namespace detail
+	{
+		//vectors are processed in blocks of this many entries, long ones spread the blocks over the pool
+		constexpr size_t VectorBlock = 1 << 12;
+
+		//calls body(block, i0, i1) on the blocks of [0, n), on the shared pool once the work is worth it
+		template <typename F>
+		void blockwise(size_t n, size_t work, F body)
+		{
+			const size_t blocks = (n + VectorBlock - 1) / VectorBlock;
+			auto run = [&](size_t first, size_t last)
+			{
+				for (size_t block = first; block < last; block++)
+				{
+					body(block, block * VectorBlock, std::min(n, (block + 1) * VectorBlock));
+				}
+			};
+			if (work < ParallelThreshold)
+			{
+				run(0, blocks);
+				return;
+			}
+			ThreadPool::shared().parallelFor(0, blocks, 1, run);
+		}
+
+		//partial sums of the blocks are added in order, so the result does not depend on the number of threads
+		template <typename T>
+		T dot(const std::vector<T>& x, const std::vector<T>& y)
+		{
+			std::vector<T> partial((x.size() + VectorBlock - 1) / VectorBlock);
+			blockwise(x.size(), x.size(), [&](size_t block, size_t i0, size_t i1)
+			{
+				T s(0);
+				for (size_t i = i0; i < i1; i++)
+				{
+					s += x[i] * y[i];
+				}
+				partial[block] = s;
+			});
+			T s(0);
+			for (const T& p : partial)
+			{
+				s += p;
+			}
+			return s;
+		}
+
+		template <typename T>
+		T norm(const std::vector<T>& x)
+		{
+			return std::sqrt(dot(x, x));
+		}
+
+		//y += alpha*x
+		template <typename T>
+		void axpy(const T& alpha, const std::vector<T>& x, std::vector<T>& y)
+		{
+			blockwise(x.size(), x.size(), [&](size_t, size_t i0, size_t i1)
+			{
+				for (size_t i = i0; i < i1; i++)
+				{
+					y[i] += alpha * x[i];
+				}
+			});
+		}
+
+		//r = b - A*x
+		template <typename T, typename Op>
+		void residual(const Op& A, const std::vector<T>& b, const std::vector<T>& x, std::vector<T>& r)
+		{
+			A(x, r);
+			for (size_t i = 0; i < b.size(); i++)
+			{
+				r[i] = b[i] - r[i];
+			}
+		}
+
+		//validates the right-hand side and prepares the initial guess, returns ||b||
+		template <typename T>
+		T prepareSolve(const std::vector<T>& b, std::vector<T>& x, const SolverOptions<T>& options)
+		{
+			static_assert(std::is_floating_point_v<T>, "Iterative solvers require a floating point element type!");
+			if (x.empty())
+			{
+				x.assign(b.size(), T(0));
+			}
+			if (x.size() != b.size())
+			{
+				throw std::invalid_argument("Initial guess has to match the right-hand side!");
+			}
+			if (!(options.tolerance > T(0)))
+			{
+				throw std::invalid_argument("Tolerance has to be positive!");
+			}
+			return norm(b);
+		}
+
+		template <typename T>
+		auto matrixOperator(const Matrix<T>& A) noexcept(false)
+		{
+			if (A.getCountRows() != A.getCountColumns())
+			{
+				throw std::invalid_argument("Iterative solvers require a square matrix!");
+			}
+			return [&A](const std::vector<T>& x, std::vector<T>& y) { gemv(T(1), A, Transpose::No, x, T(0), y); };
+		}
+	}
+
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix(std::vector<size_t> RowStart, std::vector<size_t> Column, std::vector<T> Values) noexcept(false)
+		: rowStart(std::move(RowStart)), column(std::move(Column)), values(std::move(Values))
+	{
+		if (rowStart.empty() || rowStart.front() != 0 || rowStart.back() != column.size() || column.size() != values.size())
+		{
+			throw std::invalid_argument("Malformed compressed sparse rows!");
+		}
+		const size_t n = rowStart.size() - 1;
+		for (size_t i = 0; i < n; i++)
+		{
+			if (rowStart[i] > rowStart[i + 1])
+			{
+				throw std::invalid_argument("Malformed compressed sparse rows!");
+			}
+			for (size_t p = rowStart[i]; p < rowStart[i + 1]; p++)
+			{
+				if (column[p] >= n || (p > rowStart[i] && column[p] <= column[p - 1]))
+				{
+					throw std::invalid_argument("Malformed compressed sparse rows!");
+				}
+			}
+		}
+	}
+
+	template <typename T>
+	SparseMatrix<T>::SparseMatrix(const Matrix<T>& A) noexcept(false) : rowStart(1, 0), column(), values()
+	{
+		if (A.getCountRows() != A.getCountColumns())
+		{
+			throw std::invalid_argument("Sparse matrix has to be square!");
+		}
+		for (size_t i = 0; i < A.getCountRows(); i++)
+		{
+			for (size_t j = 0; j < A.getCountColumns(); j++)
+			{
+				if (A(i, j) != T(0))
+				{
+					column.push_back(j);
+					values.push_back(A(i, j));
+				}
+			}
+			rowStart.push_back(column.size());
+		}
+	}
+
+	template <typename T>
+	void SparseMatrix<T>::operator()(const std::vector<T>& x, std::vector<T>& y) const noexcept(false)
+	{
+		const size_t n = getCountRows();
+		if (x.size() != n)
+		{
+			throw std::invalid_argument("Vector has to have as many entries as the sparse matrix has columns!");
+		}
+		y.resize(n);
+		//every block owns its rows of y, the work is proportional to the stored fields
+		detail::blockwise(n, values.size(), [&](size_t, size_t i0, size_t i1)
+		{
+			for (size_t i = i0; i < i1; i++)
+			{
+				T s(0);
+				for (size_t p = rowStart[i]; p < rowStart[i + 1]; p++)
+				{
+					s += values[p] * x[column[p]];
+				}
+				y[i] = s;
+			}
+		});
+	}
+
+	template <typename T>
+	Matrix<T> SparseMatrix<T>::toMatrix() const
+	{
+		Matrix<T> A(getCountRows(), getCountColumns());
+		for (size_t i = 0; i < getCountRows(); i++)
+		{
+			for (size_t p = rowStart[i]; p < rowStart[i + 1]; p++)
+			{
+				A(i, column[p]) = values[p];
+			}
+		}
+		return A;
+	}
+
+	template <typename T>
+	JacobiPreconditioner<T>::JacobiPreconditioner(const std::vector<T>& Diagonal) noexcept(false) : inverse(Diagonal.size())
+	{
+		for (size_t i = 0; i < Diagonal.size(); i++)
+		{
+			if (Diagonal[i] == T(0))
+			{
+				throw std::domain_error("Jacobi preconditioner requires a nonzero diagonal!");
+			}
+			inverse[i] = T(1) / Diagonal[i];
+		}
+	}
+
+	template <typename T>
+	JacobiPreconditioner<T>::JacobiPreconditioner(const Matrix<T>& A) noexcept(false)
+	{
+		if (A.getCountRows() != A.getCountColumns())
+		{
+			throw std::invalid_argument("Preconditioner requires a square matrix!");
+		}
+		std::vector<T> diag(A.getCountRows());
+		for (size_t i = 0; i < diag.size(); i++)
+		{
+			diag[i] = A(i, i);
+		}
+		*this = JacobiPreconditioner(diag);
+	}
+
+	template <typename T>
+	void JacobiPreconditioner<T>::operator()(const std::vector<T>& r, std::vector<T>& z) const
+	{
+		z.resize(r.size());
+		for (size_t i = 0; i < r.size(); i++)
+		{
+			z[i] = inverse[i] * r[i];
+		}
+	}
+
+	template <typename T>
+	ILU0Preconditioner<T>::ILU0Preconditioner(const SparseMatrix<T>& A) noexcept(false)
+		: rowStart(A.getRowStart()), column(A.getColumnIndices()), diagonal(), values(A.getValues())
+	{
+		factorize();
+	}
+
+	template <typename T>
+	ILU0Preconditioner<T>::ILU0Preconditioner(std::vector<size_t> RowStart, std::vector<size_t> Column, std::vector<T> Values) noexcept(false)
+		: ILU0Preconditioner(SparseMatrix<T>(std::move(RowStart), std::move(Column), std::move(Values)))
+	{
+	}
+
+	template <typename T>
+	ILU0Preconditioner<T>::ILU0Preconditioner(const Matrix<T>& A) noexcept(false) : ILU0Preconditioner(SparseMatrix<T>(A))
+	{
+	}
+
+	template <typename T>
+	void ILU0Preconditioner<T>::factorize() noexcept(false)
+	{
+		const size_t n = rowStart.size() - 1;
+		const size_t none = std::numeric_limits<size_t>::max();
+		diagonal.assign(n, none);
+		for (size_t i = 0; i < n; i++)
+		{
+			//the pattern was validated by SparseMatrix
+			for (size_t p = rowStart[i]; p < rowStart[i + 1]; p++)
+			{
+				if (column[p] == i)
+				{
+					diagonal[i] = p;
+				}
+			}
+			if (diagonal[i] == none)
+			{
+				throw std::domain_error("ILU(0) requires every diagonal field in the sparsity pattern!");
+			}
+		}
+		//IKJ elimination restricted to the pattern, position maps the columns of row i to their slots
+		std::vector<size_t> position(n, none);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t p = rowStart[i]; p < rowStart[i + 1]; p++)
+			{
+				position[column[p]] = p;
+			}
+			for (size_t p = rowStart[i]; p < diagonal[i]; p++)
+			{
+				const size_t k = column[p];
+				values[p] /= values[diagonal[k]];
+				for (size_t q = diagonal[k] + 1; q < rowStart[k + 1]; q++)
+				{
+					if (position[column[q]] != none)
+					{
+						values[position[column[q]]] -= values[p] * values[q];
+					}
+				}
+			}
+			if (values[diagonal[i]] == T(0))
+			{
+				throw std::domain_error("ILU(0) met a zero pivot!");
+			}
+			for (size_t p = rowStart[i]; p < rowStart[i + 1]; p++)
+			{
+				position[column[p]] = none;
+			}
+		}
+	}
+
+	template <typename T>
+	void ILU0Preconditioner<T>::operator()(const std::vector<T>& r, std::vector<T>& z) const
+	{
+		const size_t n = rowStart.size() - 1;
+		z.resize(n);
+		//L*w = r with unit diagonal
+		for (size_t i = 0; i < n; i++)
+		{
+			T s = r[i];
+			for (size_t p = rowStart[i]; p < diagonal[i]; p++)
+			{
+				s -= values[p] * z[column[p]];
+			}
+			z[i] = s;
+		}
+		//U*z = w
+		for (size_t i = n; i-- > 0;)
+		{
+			T s = z[i];
+			for (size_t p = diagonal[i] + 1; p < rowStart[i + 1]; p++)
+			{
+				s -= values[p] * z[column[p]];
+			}
+			z[i] = s / values[diagonal[i]];
+		}
+	}
+
+	template <typename T, typename Op, typename Pre>
+		requires LinearOperator<Op, T>
+	SolverResult<T> cg(const Op& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M, const SolverOptions<T>& options) noexcept(false)
+	{
+		const T bnorm = detail::prepareSolve(b, x, options);
+		const size_t n = b.size();
+		SolverResult<T> result;
+		if (bnorm == T(0))
+		{
+			x.assign(n, T(0));
+			result.converged = true;
+			return result;
+		}
+		std::vector<T> r(n), z(n), p, Ap(n);
+		detail::residual(A, b, x, r);
+		result.residual = detail::norm(r) / bnorm;
+		if (result.residual <= options.tolerance)
+		{
+			result.converged = true;
+			return result;
+		}
+		M(r, z);
+		p = z;
+		T rz = detail::dot(r, z);
+		while (result.iterations < options.maxIterations)
+		{
+			A(p, Ap);
+			const T curvature = detail::dot(p, Ap);
+			if (curvature == T(0))
+			{
+				break;
+			}
+			const T alpha = rz / curvature;
+			detail::axpy(alpha, p, x);
+			detail::axpy(-alpha, Ap, r);
+			result.iterations++;
+			result.residual = detail::norm(r) / bnorm;
+			if (result.residual <= options.tolerance)
+			{
+				result.converged = true;
+				break;
+			}
+			M(r, z);
+			const T next = detail::dot(r, z);
+			const T beta = next / rz;
+			rz = next;
+			for (size_t i = 0; i < n; i++)
+			{
+				p[i] = z[i] + beta * p[i];
+			}
+		}
+		return result;
+	}
+
+	template <typename T, typename Op, typename Pre>
+		requires LinearOperator<Op, T>
+	SolverResult<T> gmres(const Op& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M, const SolverOptions<T>& options) noexcept(false)
+	{
+		const T bnorm = detail::prepareSolve(b, x, options);
+		const size_t n = b.size();
+		SolverResult<T> result;
+		if (bnorm == T(0))
+		{
+			x.assign(n, T(0));
+			result.converged = true;
+			return result;
+		}
+		const size_t m = std::max<size_t>(1, std::min(options.restart, n));
+		std::vector<std::vector<T>> V(m + 1, std::vector<T>(n)), Z(m, std::vector<T>(n));
+		//Hessenberg matrix reduced to upper triangular form by Givens rotations as it is built
+		Matrix<T> H(m + 1, m);
+		std::vector<T> g(m + 1), cs(m), sn(m), w(n);
+		while (true)
+		{
+			detail::residual(A, b, x, V[0]);
+			const T beta = detail::norm(V[0]);
+			result.residual = beta / bnorm;
+			if (result.residual <= options.tolerance)
+			{
+				result.converged = true;
+				return result;
+			}
+			if (result.iterations >= options.maxIterations)
+			{
+				return result;
+			}
+			for (T& v : V[0])
+			{
+				v /= beta;
+			}
+			std::fill(g.begin(), g.end(), T(0));
+			g[0] = beta;
+			size_t steps = 0;
+			bool breakdown = false;
+			while (steps < m && result.iterations < options.maxIterations)
+			{
+				const size_t j = steps;
+				M(V[j], Z[j]);
+				A(Z[j], w);
+				//modified Gram-Schmidt against the basis
+				for (size_t i = 0; i <= j; i++)
+				{
+					H(i, j) = detail::dot(w, V[i]);
+					detail::axpy(-H(i, j), V[i], w);
+				}
+				H(j + 1, j) = detail::norm(w);
+				breakdown = H(j + 1, j) <= std::numeric_limits<T>::epsilon() * beta;
+				if (!breakdown)
+				{
+					for (size_t k = 0; k < n; k++)
+					{
+						V[j + 1][k] = w[k] / H(j + 1, j);
+					}
+				}
+				for (size_t i = 0; i < j; i++)
+				{
+					const T t = cs[i] * H(i, j) + sn[i] * H(i + 1, j);
+					H(i + 1, j) = -sn[i] * H(i, j) + cs[i] * H(i + 1, j);
+					H(i, j) = t;
+				}
+				const T r = std::hypot(H(j, j), H(j + 1, j));
+				cs[j] = r == T(0) ? T(1) : H(j, j) / r;
+				sn[j] = r == T(0) ? T(0) : H(j + 1, j) / r;
+				H(j, j) = r;
+				H(j + 1, j) = T(0);
+				g[j + 1] = -sn[j] * g[j];
+				g[j] = cs[j] * g[j];
+				steps++;
+				result.iterations++;
+				if (breakdown || std::abs(g[j + 1]) / bnorm <= options.tolerance)
+				{
+					break;
+				}
+			}
+			//x += Z*y with H*y = g
+			std::vector<T> y(steps);
+			for (size_t i = steps; i-- > 0;)
+			{
+				T s = g[i];
+				for (size_t k = i + 1; k < steps; k++)
+				{
+					s -= H(i, k) * y[k];
+				}
+				y[i] = H(i, i) == T(0) ? T(0) : s / H(i, i);
+			}
+			for (size_t i = 0; i < steps; i++)
+			{
+				detail::axpy(y[i], Z[i], x);
+			}
+			if (breakdown && std::abs(g[steps]) / bnorm > options.tolerance)
+			{
+				//the Krylov space is exhausted without reaching the tolerance, restarting cannot help
+				detail::residual(A, b, x, w);
+				result.residual = detail::norm(w) / bnorm;
+				result.converged = result.residual <= options.tolerance;
+				return result;
+			}
+		}
+	}
+
+	template <typename T, typename Op, typename Pre>
+		requires LinearOperator<Op, T>
+	SolverResult<T> bicgstab(const Op& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M, const SolverOptions<T>& options) noexcept(false)
+	{
+		const T bnorm = detail::prepareSolve(b, x, options);
+		const size_t n = b.size();
+		SolverResult<T> result;
+		if (bnorm == T(0))
+		{
+			x.assign(n, T(0));
+			result.converged = true;
+			return result;
+		}
+		std::vector<T> r(n), p(n, T(0)), v(n, T(0)), s(n), t(n), ph(n), sh(n);
+		detail::residual(A, b, x, r);
+		result.residual = detail::norm(r) / bnorm;
+		if (result.residual <= options.tolerance)
+		{
+			result.converged = true;
+			return result;
+		}
+		const std::vector<T> shadow = r;
+		T rho(1), alpha(1), omega(1);
+		while (result.iterations < options.maxIterations)
+		{
+			const T next = detail::dot(shadow, r);
+			if (next == T(0) || omega == T(0))
+			{
+				break;
+			}
+			const T beta = (next / rho) * (alpha / omega);
+			rho = next;
+			for (size_t i = 0; i < n; i++)
+			{
+				p[i] = r[i] + beta * (p[i] - omega * v[i]);
+			}
+			M(p, ph);
+			A(ph, v);
+			const T projection = detail::dot(shadow, v);
+			if (projection == T(0))
+			{
+				break;
+			}
+			alpha = rho / projection;
+			for (size_t i = 0; i < n; i++)
+			{
+				s[i] = r[i] - alpha * v[i];
+			}
+			result.iterations++;
+			if (detail::norm(s) / bnorm <= options.tolerance)
+			{
+				detail::axpy(alpha, ph, x);
+				result.residual = detail::norm(s) / bnorm;
+				result.converged = true;
+				break;
+			}
+			M(s, sh);
+			A(sh, t);
+			const T tt = detail::dot(t, t);
+			omega = tt == T(0) ? T(0) : detail::dot(t, s) / tt;
+			for (size_t i = 0; i < n; i++)
+			{
+				x[i] += alpha * ph[i] + omega * sh[i];
+				r[i] = s[i] - omega * t[i];
+			}
+			result.residual = detail::norm(r) / bnorm;
+			if (result.residual <= options.tolerance)
+			{
+				result.converged = true;
+				break;
+			}
+		}
+		return result;
+	}
+
+	template <typename T, typename Pre>
+	SolverResult<T> cg(const Matrix<T>& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M, const SolverOptions<T>& options) noexcept(false)
+	{
+		return cg(detail::matrixOperator(A), b, x, M, options);
+	}
+
+	template <typename T, typename Pre>
+	SolverResult<T> gmres(const Matrix<T>& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M, const SolverOptions<T>& options) noexcept(false)
+	{
+		return gmres(detail::matrixOperator(A), b, x, M, options);
+	}
+
+	template <typename T, typename Pre>
+	SolverResult<T> bicgstab(const Matrix<T>& A, const std::vector<T>& b, std::vector<T>& x, const Pre& M, const SolverOptions<T>& options) noexcept(false)
+	{
+		return bicgstab(detail::matrixOperator(A), b, x, M, options);
+	}
+}
@@ -5,14 +5,186 @@
 #include <string>
 #include <cmath>
 #include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <span>
+#include <memory>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include "Kernels.hpp"
 
 namespace LinearAlgebra
 {
+	//allocator default-initializing the fields instead of value-initializing them,
+	//for arithmetic types resizing the storage leaves the memory untouched
+	template <typename T, typename A = std::allocator<T>>
+	class DefaultInitAllocator : public A
+	{
+		typedef std::allocator_traits<A> Traits;
+
+	public:
+		template <typename U>
+		struct rebind
+		{
+			using other = DefaultInitAllocator<U, typename Traits::template rebind_alloc<U>>;
+		};
+
+		using A::A;
+
+		template <typename U>
+		void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+		{
+			::new (static_cast<void*>(ptr)) U;
+		}
+
+		template <typename U, typename... Args>
+		void construct(U* ptr, Args&&... args)
+		{
+			Traits::construct(static_cast<A&>(*this), ptr, std::forward<Args>(args)...);
+		}
+	};
+
+	//tag selecting constructors which leave the fields of the matrix uninitialized
+	struct Uninitialized_t
+	{
+		explicit Uninitialized_t() = default;
+	};
+
+	inline constexpr Uninitialized_t Uninitialized{};
+
+	namespace detail
+	{
+		//reference counted buffer shared by copies of a matrix until one of them writes,
+		//the writer then detaches onto its own copy of the fields
+		template <typename S>
+		class SharedBuffer
+		{
+			struct Block
+			{
+				S fields;
+				std::atomic<size_t> owners;
+				//cleared once references into the fields were handed out, copies then take their own fields;
+				//only the sole owner changes it, so it needs no synchronization
+				bool shareable = true;
+			};
+			Block* block = nullptr;
+
+			void release() noexcept
+			{
+				//acq_rel so that the reads of every former owner happen before the fields are freed or reused
+				if (block && block->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					delete block;
+				}
+				block = nullptr;
+			}
+
+			static const S& none() noexcept
+			{
+				static const S empty;
+				return empty;
+			}
+
+		public:
+			SharedBuffer() noexcept = default;
+
+			explicit SharedBuffer(S&& fields) : block(new Block{ std::move(fields), 1 }) {}
+
+			//shares the fields unless they were exposed, may throw std::bad_alloc then
+			SharedBuffer(const SharedBuffer& other) : block(other.block)
+			{
+				if (block && !block->shareable)
+				{
+					block = new Block{ other.block->fields, 1 };
+				}
+				else if (block)
+				{
+					block->owners.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+
+			SharedBuffer(SharedBuffer&& other) noexcept : block(std::exchange(other.block, nullptr)) {}
+
+			SharedBuffer& operator=(SharedBuffer other) noexcept
+			{
+				std::swap(block, other.block);
+				return *this;
+			}
+
+			~SharedBuffer() { release(); }
+
+			//fields for reading, never detaches
+			const S& read() const noexcept { return block ? block->fields : none(); }
+
+			//fields for writing, copies them first if another owner shares them
+			S& write()
+			{
+				if (!block)
+				{
+					block = new Block{ S(), 1 };
+				}
+				//acquire pairs with the release of the last other owner, its reads happen before our writes
+				else if (block->owners.load(std::memory_order_acquire) != 1)
+				{
+					Block* copy = new Block{ block->fields, 1 };
+					release();
+					block = copy;
+				}
+				return block->fields;
+			}
+
+			//fields for writing through references the caller keeps, later copies no longer share them
+			S& expose()
+			{
+				S& fields = write();
+				block->shareable = false;
+				return fields;
+			}
+		};
+	}
+
+	//storage layouts of Matrix, RowMajor keeps the rows contiguous one after another
+	struct RowMajor {};
+
+	//sequence in which the tiles of a Tiled layout follow each other
+	enum class TileOrder { RowMajor, Morton };
+
+	//layout keeping the fields in Size x Size tiles, each contiguous and row-major inside, Size being a power of two;
+	//the tiles themselves follow each other row after row or in Z-order (Morton); defined in Tiled.hpp
+	template <size_t Size = 32, TileOrder Order = TileOrder::Morton>
+	struct Tiled {};
+
+	template <typename T, typename Layout = RowMajor>
+	class Matrix;
+
 	template <typename T>
-	class Matrix
+	class Matrix<T, RowMajor>
 	{
-		std::vector<std::vector<T>> context;
+	public:
+		//type of the buffer holding the fields, may be adopted by the matrix without copying
+		typedef std::vector<T, DefaultInitAllocator<T>> Storage;
+
+	private:
+		//row-major storage, row i starts at context[i*stride], fields past columns in a row are spare capacity;
+		//copies share it until one of them is written, or copy it right away once non-const access exposed it
+		detail::SharedBuffer<Storage> context;
 		size_t rows, columns;
+		size_t stride;
+
+		//other layouts and the products write their results through context without exposing the fields
+		template <typename, typename> friend class Matrix;
+		template <typename U> friend void gemm(const U& alpha, const Matrix<U>& A, Transpose transA, const Matrix<U>& B, Transpose transB, const U& beta, Matrix<U>& C) noexcept(false);
+		template <typename U> friend void syrk(Triangle part, const U& alpha, const Matrix<U>& A, Transpose trans, const U& beta, Matrix<U>& C) noexcept(false);
+
+		//moves the rows into storage with the given column capacity
+		void relayout(const size_t& newStride);
+
+		//makes room for given number of rows, growing the capacity geometrically
+		void growRows(const size_t& newRows);
+
+		//makes room for given number of columns, growing the capacity geometrically
+		void growColumns(const size_t& newColumns);
 
 	public:
 		//default constructor
@@ -22,32 +194,49 @@ namespace LinearAlgebra
 		//constructor
 		Matrix(const size_t& M, const size_t& N);
 
+		//constructor leaving the fields uninitialized, they have to be written before being read
+		Matrix(const size_t& M, const size_t& N, Uninitialized_t);
+
 		//constructor assigning values generated by the function
-		Matrix(const size_t& M, const size_t& N,std::function<T()>W);
+		template <typename Generator> requires std::is_invocable_r_v<T, Generator&>
+		Matrix(const size_t& M, const size_t& N, Generator W);
 
-		//copying constructor
-		Matrix(const Matrix<T>& Q);
+		//constructor copying M*N values stored row after row
+		Matrix(const size_t& M, const size_t& N, std::span<const T> values) noexcept(false);
+
+		//constructor adopting M*N values stored row after row, no copy is made
+		Matrix(const size_t& M, const size_t& N, Storage&& values) noexcept(false);
+
+		//copying constructor, shares the fields of Q until either matrix is written;
+		//fields exposed by non-const access of Q are copied right away, which may throw std::bad_alloc
+		Matrix(const Matrix<T>& Q) noexcept(false);
+
+		//moving constructor, Q is left empty
+		Matrix(Matrix<T>&& Q) noexcept;
 
 		//accesses row of given index without boundary checks
-		std::vector<T>& operator[](const size_t& index) { return context[index]; }
+		std::span<T> operator[](const size_t& index) { return std::span<T>(context.expose().data() + index * stride, columns); }
 
-		constexpr const std::vector<T>& operator[](const size_t& index) const { return context[index]; }
+		std::span<const T> operator[](const size_t& index) const { return std::span<const T>(context.read().data() + index * stride, columns); }
 
 		//accesses field of context without bondary checks
-		T& operator()(const size_t& Row, const size_t& Col) {return context[Row][Col];}
+		T& operator()(const size_t& Row, const size_t& Col) {return context.expose()[Row * stride + Col];}
 
-		constexpr const T& operator()(const size_t& Row, const size_t& Col) const {return context[Row][Col]; }
+		constexpr const T& operator()(const size_t& Row, const size_t& Col) const {return context.read()[Row * stride + Col]; }
 
 		//accesses field of context with boundary checks
-		constexpr T& at (const size_t& Row, const size_t& Col) noexcept(false) {return (context.at(Row)).at(Col);}
+		constexpr T& at (const size_t& Row, const size_t& Col) noexcept(false) { if (Row >= rows || Col >= columns) { throw std::out_of_range("Matrix field out of range!"); } return context.expose()[Row * stride + Col]; }
 
-		constexpr const T& at(const size_t& Row, const size_t& Col) const noexcept(false) {return (context.at(Row)).at(Col);}
+		constexpr const T& at(const size_t& Row, const size_t& Col) const noexcept(false) { if (Row >= rows || Col >= columns) { throw std::out_of_range("Matrix field out of range!"); } return context.read()[Row * stride + Col]; }
 
 		//returns true iff two objects have are equal
-		constexpr bool operator==(const Matrix<T>& other)const { return (context == other.context&&rows==other.rows&&other.columns); }
+		bool operator==(const Matrix<T>& other) const;
 
-		//copies object
-		Matrix<T> operator=(const Matrix<T>& index) noexcept;
+		//copies object, sharing the fields until either matrix is written unless non-const access exposed them
+		Matrix<T>& operator=(const Matrix<T>& index) noexcept(false);
+
+		//takes over the storage of index, which is left empty
+		Matrix<T>& operator=(Matrix<T>&& index) noexcept;
 
 		//addition of matrices
 		Matrix<T> operator+(const Matrix<T>& W) const noexcept(false);
@@ -65,19 +254,19 @@ namespace LinearAlgebra
 		Matrix<T> operator*(const Matrix<T>& B) const noexcept(false);
 
 		//matrix addition
-		Matrix<T> operator+=(const Matrix<T>& W) noexcept(false);
+		Matrix<T>& operator+=(const Matrix<T>& W) noexcept(false);
 
 		//matrix subtraction
-		Matrix<T> operator-=(const Matrix<T>& W) noexcept(false);
+		Matrix<T>& operator-=(const Matrix<T>& W) noexcept(false);
 
 		//scalar multiplication
-		Matrix<T> operator*=(const T& C) noexcept;
+		Matrix<T>& operator*=(const T& C) noexcept(false);
 
 		//matrix multiplication
-		Matrix<T> operator*=(const Matrix<T>& W) noexcept(false);
+		Matrix<T>& operator*=(const Matrix<T>& W) noexcept(false);
 
 		//scalar multiplication
-		Matrix<T> operator/=(const T& C) noexcept(false);
+		Matrix<T>& operator/=(const T& C) noexcept(false);
 
 		//return Matrix<T>'s transposition
 		Matrix<T> transposed() const noexcept;
@@ -94,6 +283,21 @@ namespace LinearAlgebra
 		//add another row to matrix
 		void expandRow(const std::vector<T>& newRow) noexcept(false);
 
+		//add count rows stored one after another in values
+		void appendRows(std::span<const T> values, const size_t& count) noexcept(false);
+
+		//add count columns stored one after another (each column contiguous) in values
+		void appendColumns(std::span<const T> values, const size_t& count) noexcept(false);
+
+		//preallocate storage for given number of rows and columns, keeps the contents
+		void reserve(const size_t& rowCapacity, const size_t& columnCapacity);
+
+		//release the capacity exceeding the current dimensions
+		void shrink_to_fit();
+
+		size_t getCapacityRows() const noexcept { return stride ? context.read().capacity() / stride : 0; }
+		size_t getCapacityColumns() const noexcept { return stride; }
+
 		//returns row of given index (from 0 to N-1)
 		std::vector<T> extractRow(size_t index) const noexcept;
 
@@ -110,39 +314,51 @@ namespace LinearAlgebra
 
 		void free() noexcept;
 
-		//returns the sum of all the elements of the matrix
-		const T sum() const noexcept;
+		//returns the sum of all the elements of the matrix, integer sums throw std::overflow_error instead of wrapping
+		const T sum() const noexcept(false);
 
-		//return the supremum of set consisting of all the fields in matrix
+		//return the supremum of set consisting of all the fields in matrix (zero for empty matrix)
 		const T max() const noexcept;
 
 		//element wise multiplication of two matrices
 		Matrix<T> hadamardProduct(const Matrix<T>& B) const noexcept(false);
-		
+
 		Matrix<T> applyOperation(const Matrix<T>& other, std::function<T(const T&, const T&)>f) const noexcept(false);
 
 		Matrix<T> applyOperation(std::function<T(const T&)>f) const noexcept;
 
-		Matrix<T> modify(std::function<void(T&)>f) noexcept;
+		//modifying functions detach shared fields first, which may throw std::bad_alloc
+		Matrix<T> modify(std::function<void(T&)>f) noexcept(false);
+
+		Matrix<T> modify(std::function<T(const T&)>f) noexcept(false);
 
-		Matrix<T> modify(std::function<T(const T&)>f) noexcept;
-		
 		size_t getCountRows() const noexcept { return rows; }
 		size_t getCountColumns() const noexcept { return columns; }
 
+		//raw row-major storage, row i starts at data()+i*getStride()
+		T* data() { return context.expose().data(); }
+		const T* data() const noexcept { return context.read().data(); }
+		size_t getStride() const noexcept { return stride; }
+
 		constexpr bool empty() const noexcept;
 
 		constexpr T det() const noexcept(false);
 
 		constexpr T cofactor(const size_t& i, const size_t& j) const noexcept(false);
 
+	private:
+		//fraction-free Gaussian elimination, exact determinant of integer matrix in O(n^3)
+		T bareiss() const noexcept(false);
+
+	public:
+
 		Matrix<T> adjoint() const noexcept(false);
 
 		Matrix<T> inverse() const noexcept(false);
 	};
 
 	template<typename T>
-	Matrix<T>::Matrix() :context(), rows(0), columns(0)
+	Matrix<T>::Matrix() :context(), rows(0), columns(0), stride(0)
 	{
 
 	}
@@ -150,58 +366,141 @@ namespace LinearAlgebra
 	template<typename T>
 	Matrix<T>::~Matrix()
 	{
-		if (!context.empty())
-		{
-			context.erase(context.begin(), context.end());
-		}
 		rows = 0;
 		columns = 0;
+		stride = 0;
 	}
 
 	template<typename T>
-	Matrix<T>::Matrix(const size_t& M, const size_t& N) :context(), rows(M), columns(N)
+	Matrix<T>::Matrix(const size_t& M, const size_t& N) :context(Storage(M * N, T(0))), rows(M), columns(N), stride(N)
 	{
-		std::vector<T> E;
-		for (size_t i = 0; i < N; i++)
+	}
+
+	template<typename T>
+	Matrix<T>::Matrix(const size_t& M, const size_t& N, Uninitialized_t) :context(Storage(M * N)), rows(M), columns(N), stride(N)
+	{
+	}
+
+	template<typename T>
+	template<typename Generator> requires std::is_invocable_r_v<T, Generator&>
+	Matrix<T>::Matrix(const size_t& M, const size_t& N, Generator W) :context(Storage(M * N)), rows(M), columns(N), stride(N)
+	{
+		for (T& field : context.write())
 		{
-			E.push_back(0);
+			field = W();
 		}
-		for (size_t i = 0; i < M; i++)
+	}
+
+	template<typename T>
+	Matrix<T>::Matrix(const size_t& M, const size_t& N, std::span<const T> values) noexcept(false) :context(), rows(M), columns(N), stride(N)
+	{
+		if (values.size() != M * N)
+		{
+			throw std::invalid_argument("Number of values doesn't match dimensions of the matrix!");
+		}
+		context = detail::SharedBuffer<Storage>(Storage(values.begin(), values.end()));
+	}
+
+	template<typename T>
+	Matrix<T>::Matrix(const size_t& M, const size_t& N, Storage&& values) noexcept(false) :context(), rows(M), columns(N), stride(N)
+	{
+		if (values.size() != M * N)
+		{
+			throw std::invalid_argument("Number of values doesn't match dimensions of the matrix!");
+		}
+		context = detail::SharedBuffer<Storage>(std::move(values));
+	}
+
+	template<typename T>
+	Matrix<T>::Matrix(const Matrix<T>& Q) noexcept(false) :context(Q.context), rows(Q.rows), columns(Q.columns), stride(Q.stride)
+	{
+	}
+
+	template<typename T>
+	void Matrix<T>::relayout(const size_t& newStride)
+	{
+		Storage moved;
+		moved.reserve(getCapacityRows() * newStride);
+		moved.resize(rows * newStride, T(0));
+		const size_t kept = std::min(columns, newStride);
+		for (size_t i = 0; i < rows; i++)
 		{
-			context.push_back(E);
+			std::copy_n(context.read().begin() + i * stride, kept, moved.begin() + i * newStride);
 		}
+		context = detail::SharedBuffer<Storage>(std::move(moved));
+		stride = newStride;
 	}
 
 	template<typename T>
-	Matrix<T>::Matrix(const size_t& M, const size_t& N, std::function<T()> W) :context(), rows(M), columns(N)
+	void Matrix<T>::growRows(const size_t& newRows)
 	{
-		for (size_t i = 0; i < M; i++)
+		Storage& fields = context.write();
+		if (newRows * stride > fields.capacity())
 		{
-			std::vector<T> E;
-			for (size_t i = 0; i < N; i++)
+			fields.reserve(std::max(newRows, 2 * getCapacityRows()) * stride);
+		}
+		fields.resize(newRows * stride, T(0));
+	}
+
+	template<typename T>
+	void Matrix<T>::growColumns(const size_t& newColumns)
+	{
+		if (newColumns > stride)
+		{
+			relayout(std::max(newColumns, 2 * stride));
+		}
+	}
+
+	template<typename T>
+	bool Matrix<T>::operator==(const Matrix<T>& other) const
+	{
+		if (rows != other.rows || columns != other.columns)
+		{
+			return false;
+		}
+		for (size_t i = 0; i < rows; i++)
+		{
+			if (!std::equal((*this)[i].begin(), (*this)[i].end(), other[i].begin()))
 			{
-				E.push_back(W());
+				return false;
 			}
-			context.push_back(E);
 		}
+		return true;
 	}
 
 	template<typename T>
-	Matrix<T>::Matrix(const Matrix<T>& Q) :columns(Q.columns), rows(Q.rows), context(Q.context)
+	Matrix<T>::Matrix(Matrix<T>&& Q) noexcept :context(std::move(Q.context)), rows(Q.rows), columns(Q.columns), stride(Q.stride)
 	{
+		Q.free();
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::operator=(const Matrix<T>& index) noexcept
+	Matrix<T>& Matrix<T>::operator=(const Matrix<T>& index) noexcept(false)
 	{
 		if (this == &index)
 		{
 			return *this;
 		}
-		this->context.erase(context.begin(), context.end());
+		//the fields first, copying exposed ones may throw and must leave this matrix intact
+		this->context = index.context;
 		this->columns = index.columns;
 		this->rows = index.rows;
-		this->context = index.context;
+		this->stride = index.stride;
+		return *this;
+	}
+
+	template<typename T>
+	Matrix<T>& Matrix<T>::operator=(Matrix<T>&& index) noexcept
+	{
+		if (this == &index)
+		{
+			return *this;
+		}
+		this->columns = index.columns;
+		this->rows = index.rows;
+		this->stride = index.stride;
+		this->context = std::move(index.context);
+		index.free();
 		return *this;
 	}
 
@@ -213,12 +512,15 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Addition of matrices is undefined!");
 		}
-		Matrix<T> A(rows, columns);
+		Matrix<T> A(rows, columns, Uninitialized);
+		T* out = A.context.write().data();
+		const T* x = data();
+		const T* y = W.data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				A[i][j] = context[i][j] + (W.context[i])[j];
+				out[i * columns + j] = x[i * stride + j] + y[i * W.stride + j];
 			}
 		}
 		return A;
@@ -232,12 +534,15 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Subtraction of matrices is undefined!");
 		}
-		Matrix<T> A(rows, columns);
+		Matrix<T> A(rows, columns, Uninitialized);
+		T* out = A.context.write().data();
+		const T* x = data();
+		const T* y = W.data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				A[i][j] = context[i][j] - W.context[i][j];
+				out[i * columns + j] = x[i * stride + j] - y[i * W.stride + j];
 			}
 		}
 		return A;
@@ -246,12 +551,14 @@ namespace LinearAlgebra
 	template<typename T>
 	Matrix<T> Matrix<T>::operator*(const T& C) const noexcept
 	{
-		Matrix<T> A(rows, columns);
+		Matrix<T> A(rows, columns, Uninitialized);
+		T* out = A.context.write().data();
+		const T* x = data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				A[i][j] = context[i][j] * C;
+				out[i * columns + j] = x[i * stride + j] * C;
 			}
 		}
 		return A;
@@ -264,85 +571,95 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Division by zero is undefined!");
 		}
-		Matrix<T> A(rows, columns);
+		Matrix<T> A(rows, columns, Uninitialized);
+		T* out = A.context.write().data();
+		const T* x = data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				A[i][j] = context[i][j] / C;
+				out[i * columns + j] = x[i * stride + j] / C;
 			}
 		}
 		return A;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::operator+=(const Matrix<T>& W) noexcept(false)
+	Matrix<T>& Matrix<T>::operator+=(const Matrix<T>& W) noexcept(false)
 	{
 		//if dimensions don't match addition is not defined
 		if (rows != W.rows || columns != W.columns)
 		{
 			throw std::invalid_argument("Addition of matrices is undefined!");
 		}
+		//detaching first, W may share the fields or be this matrix itself
+		T* x = data();
+		const T* y = W.data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				this->context[i][j] += W.context[i][j];
+				x[i * stride + j] += y[i * W.stride + j];
 			}
 		}
 		return *this;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::operator-=(const Matrix<T>& W) noexcept(false)
+	Matrix<T>& Matrix<T>::operator-=(const Matrix<T>& W) noexcept(false)
 	{
 		//if dimensions don't match subtraction is not defined
 		if (rows != W.rows || columns != W.columns)
 		{
 			throw std::invalid_argument("Subtraction of matrices is undefined!");
 		}
+		//detaching first, W may share the fields or be this matrix itself
+		T* x = data();
+		const T* y = W.data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				this->context[i][j] -= W.context[i][j];
+				x[i * stride + j] -= y[i * W.stride + j];
 			}
 		}
 		return *this;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::operator*=(const T& C) noexcept
+	Matrix<T>& Matrix<T>::operator*=(const T& C) noexcept(false)
 	{
+		T* x = data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				this->context[i][j] *= C;
+				x[i * stride + j] *= C;
 			}
 		}
 		return *this;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::operator*=(const Matrix<T>& W) noexcept(false)
+	Matrix<T>& Matrix<T>::operator*=(const Matrix<T>& W) noexcept(false)
 	{
 		*this = (*this) * W;
 		return *this;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::operator/=(const T& C) noexcept(false)
+	Matrix<T>& Matrix<T>::operator/=(const T& C) noexcept(false)
 	{
 		if (!C)
 		{
 			throw std::invalid_argument("Division by zero is undefined!");
 		}
+		T* x = data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				this->context[i][j] /= C;
+				x[i * stride + j] /= C;
 			}
 		}
 		return *this;
@@ -355,32 +672,22 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Matrix multiplication undefined!");
 		}
-		Matrix<T> A(this->rows, B.columns);
-		for (size_t i = 0; i < this->rows; i++)
-		{
-			for (size_t j = 0; j < B.columns; j++)
-			{
-				//row i
-				//column j
-				//i-th row of *this multiplied by j-th column of B
-				for (size_t k = 0; k < this->columns; k++)
-				{
-					A[i][j] += this->context[i][k] * B.context[k][j];
-				}
-			}
-		}
+		Matrix<T> A(this->rows, B.columns, Uninitialized);
+		detail::gemm(rows, B.columns, columns, T(1), data(), stride, false, B.data(), B.stride, false, T(0), A.context.write().data(), A.stride);
 		return A;
 	}
 
 	template<typename T>
 	Matrix<T> Matrix<T>::transposed() const noexcept
 	{
-		Matrix<T> A(columns, rows);
+		Matrix<T> A(columns, rows, Uninitialized);
+		T* out = A.context.write().data();
+		const T* x = data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				A[j][i] = context[i][j];
+				out[j * rows + i] = x[i * stride + j];
 			}
 		}
 		return A;
@@ -393,12 +700,24 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Dot product is undefined for matrices of different dimensions!");
 		}
+		if constexpr (detail::isExactInteger<T>)
+		{
+			detail::Widened<T> s(0);
+			for (size_t i = 0; i < rows; i++)
+			{
+				for (size_t j = 0; j < columns; j++)
+				{
+					s = detail::checkedAdd(s, detail::checkedMul(detail::Widened<T>(B(i, j)), detail::Widened<T>((*this)(i, j))));
+				}
+			}
+			return detail::narrow<T>(s);
+		}
 		T s(0);
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				s += B.context[i][j] * context[i][j];
+				s += B(i, j) * (*this)(i, j);
 			}
 		}
 		return s;
@@ -407,10 +726,10 @@ namespace LinearAlgebra
 	template<typename T>
 	void Matrix<T>::print(std::ostream& out) const noexcept
 	{
-		for (const std::vector<T>& Q : context)
+		for (size_t i = 0; i < rows; i++)
 		{
 			out << "|";
-			for (const double& W : Q)
+			for (const T& W : (*this)[i])
 			{
 				out << W << "|";
 			}
@@ -422,25 +741,21 @@ namespace LinearAlgebra
 	template<typename T>
 	void Matrix<T>::expandColumn(const std::vector<T>& newCol) noexcept(false)
 	{
+		if (newCol.size() != rows && rows != 0)
+		{
+			throw std::invalid_argument("New column has to have as many records as there are rows!");
+		}
+		growColumns(columns + 1);
 		if (rows == 0)
 		{
-			for (size_t i = 0; i < newCol.size(); i++)
-			{
-				std::vector<T> newRow;
-				newRow.push_back(newCol[i]);
-				context.push_back(newRow);
-			}
+			//the matrix takes the height of the column, existing columns are zero in the new rows
+			growRows(newCol.size());
+			rows = newCol.size();
 		}
-		else
+		Storage& fields = context.write();
+		for (size_t i = 0; i < rows; i++)
 		{
-			if (newCol.size() != rows)
-			{
-				throw std::invalid_argument("New column has to have as many records as there are rows!");
-			}
-			for (size_t i = 0; i < rows; i++)
-			{
-				context[i].push_back(newCol[i]);
-			}
+			fields[i * stride + columns] = newCol[i];
 		}
 		columns++;
 	}
@@ -452,24 +767,104 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("New row has to have as many records as there are columns!");
 		}
-		context.push_back(newRow);
+		if (columns == 0)
+		{
+			columns = newRow.size();
+			growColumns(columns);
+		}
+		growRows(rows + 1);
+		std::copy(newRow.begin(), newRow.end(), context.write().begin() + rows * stride);
 		rows++;
-		if (columns == 0) columns = newRow.size();
+	}
+
+	template<typename T>
+	void Matrix<T>::appendRows(std::span<const T> values, const size_t& count) noexcept(false)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if (values.size() % count != 0 || (columns != 0 && values.size() != count * columns))
+		{
+			throw std::invalid_argument("New rows have to have as many records as there are columns!");
+		}
+		if (columns == 0)
+		{
+			columns = values.size() / count;
+			growColumns(columns);
+		}
+		growRows(rows + count);
+		Storage& fields = context.write();
+		for (size_t i = 0; i < count; i++)
+		{
+			std::copy_n(values.begin() + i * columns, columns, fields.begin() + (rows + i) * stride);
+		}
+		rows += count;
+	}
+
+	template<typename T>
+	void Matrix<T>::appendColumns(std::span<const T> values, const size_t& count) noexcept(false)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if (values.size() % count != 0 || (rows != 0 && values.size() != count * rows))
+		{
+			throw std::invalid_argument("New columns have to have as many records as there are rows!");
+		}
+		growColumns(columns + count);
+		if (rows == 0)
+		{
+			//the matrix takes the height of the columns, existing columns are zero in the new rows
+			growRows(values.size() / count);
+			rows = values.size() / count;
+		}
+		Storage& fields = context.write();
+		for (size_t j = 0; j < count; j++)
+		{
+			for (size_t i = 0; i < rows; i++)
+			{
+				fields[i * stride + columns + j] = values[j * rows + i];
+			}
+		}
+		columns += count;
+	}
+
+	template<typename T>
+	void Matrix<T>::reserve(const size_t& rowCapacity, const size_t& columnCapacity)
+	{
+		if (columnCapacity > stride)
+		{
+			relayout(columnCapacity);
+		}
+		context.write().reserve(rowCapacity * stride);
+	}
+
+	template<typename T>
+	void Matrix<T>::shrink_to_fit()
+	{
+		if (stride != columns)
+		{
+			relayout(columns);
+		}
+		context.write().shrink_to_fit();
 	}
 
 	template<typename T>
 	std::vector<T> Matrix<T>::extractRow(size_t index) const noexcept
 	{
-		return context[index];
+		return std::vector<T>((*this)[index].begin(), (*this)[index].end());
 	}
 
 	template<typename T>
 	std::vector<T> Matrix<T>::extractColumn(size_t index) const noexcept
 	{
 		std::vector<T> A;
+		A.reserve(rows);
 		for (size_t i = 0; i < rows; i++)
 		{
-			A.push_back(context[i][index]);
+			A.push_back((*this)(i, index));
 		}
 		return A;
 	}
@@ -481,10 +876,7 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Dimension of vector provided doesn't match dimensions of the matrix!");
 		}
-		for (size_t i = 0; i < columns; i++)
-		{
-			context[index][i]=row[i];
-		}
+		std::copy(row.begin(), row.end(), data() + index * stride);
 	}
 
 	template<typename T>
@@ -494,9 +886,10 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Dimension of vector provided doesn't match dimensions of the matrix!");
 		}
+		T* x = data();
 		for (size_t i = 0; i < rows; i++)
 		{
-			context[i][index] = column[i];
+			x[i * stride + index] = column[i];
 		}
 	}
 
@@ -506,23 +899,37 @@ namespace LinearAlgebra
 		this->context = D.context;
 		rows = D.rows;
 		columns = D.columns;
+		stride = D.stride;
 	}
 
 	template<typename T>
 	void Matrix<T>::free() noexcept
 	{
-		context.erase(context.begin(), context.end());
+		context = detail::SharedBuffer<Storage>();
 		columns = 0;
 		rows = 0;
+		stride = 0;
 	}
 
 	template<typename T>
-	const T Matrix<T>::sum() const noexcept
+	const T Matrix<T>::sum() const noexcept(false)
 	{
-		T S=0.0;
-		for (const std::vector<T>& W : context)
+		if constexpr (detail::isExactInteger<T>)
+		{
+			detail::Widened<T> S(0);
+			for (size_t i = 0; i < rows; i++)
+			{
+				for (const T& Q : (*this)[i])
+				{
+					S = detail::checkedAdd(S, detail::Widened<T>(Q));
+				}
+			}
+			return detail::narrow<T>(S);
+		}
+		T S(0);
+		for (size_t i = 0; i < rows; i++)
 		{
-			for (const T& Q : W)
+			for (const T& Q : (*this)[i])
 			{
 				S += Q;
 			}
@@ -533,10 +940,14 @@ namespace LinearAlgebra
 	template<typename T>
 	const T Matrix<T>::max() const noexcept
 	{
-		T supremum=0.0;
-		for (const std::vector<T>&row : context)
+		if (empty())
+		{
+			return T(0);
+		}
+		T supremum = (*this)(0, 0);
+		for (size_t i = 0; i < rows; i++)
 		{
-			for (const T& value : row)
+			for (const T& value : (*this)[i])
 			{
 				if (value > supremum)
 				{
@@ -554,12 +965,15 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Hadamard product is undefined for matrices of different dimensions!");
 		}
-		Matrix<T> returned(rows,columns);
+		Matrix<T> returned(rows,columns, Uninitialized);
+		T* out = returned.context.write().data();
+		const T* x = data();
+		const T* y = B.data();
 		for (size_t i = 0; i < rows; i++)
 		{
 			for (size_t j = 0; j < columns; j++)
 			{
-				returned(i, j) = context[i][j] * B.context[i][j];
+				out[i * columns + j] = x[i * stride + j] * y[i * B.stride + j];
 			}
 		}
 		return returned;
@@ -572,12 +986,15 @@ namespace LinearAlgebra
 		{
 			throw std::invalid_argument("Function applyOperation is undefined for matrices of different dimensions!");
 		}
-		Matrix<T> result(this->rows, this->columns);
+		Matrix<T> result(this->rows, this->columns, Uninitialized);
+		T* out = result.context.write().data();
+		const T* x = data();
+		const T* y = other.data();
 		for (size_t i = 0; i < this->rows; i++)
 		{
 			for (size_t j = 0; j < this->columns; j++)
 			{
-				result.at(i, j) = f(this->context[i][j], other.context[i][j]);
+				out[i * columns + j] = f(x[i * stride + j], y[i * other.stride + j]);
 			}
 		}
 		return result;
@@ -586,38 +1003,42 @@ namespace LinearAlgebra
 	template<typename T>
 	Matrix<T> Matrix<T>::applyOperation(std::function < T(const T&)>f) const noexcept
 	{
-		Matrix<T> result(this->rows, this->columns);
+		Matrix<T> result(this->rows, this->columns, Uninitialized);
+		T* out = result.context.write().data();
+		const T* x = data();
 		for (size_t i = 0; i < this->rows; i++)
 		{
 			for (size_t j = 0; j < this->columns; j++)
 			{
-				result.at(i, j) = f(this->context[i][j]);
+				out[i * columns + j] = f(x[i * stride + j]);
 			}
 		}
 		return result;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::modify(std::function<void(T&)> f) noexcept
+	Matrix<T> Matrix<T>::modify(std::function<void(T&)> f) noexcept(false)
 	{
-		for (std::vector<T>& row : context)
+		T* x = data();
+		for (size_t i = 0; i < rows; i++)
 		{
-			for (T& field : row)
+			for (size_t j = 0; j < columns; j++)
 			{
-				f(field);
+				f(x[i * stride + j]);
 			}
 		}
 		return *this;
 	}
 
 	template<typename T>
-	Matrix<T> Matrix<T>::modify(std::function<T(const T&)> f) noexcept
+	Matrix<T> Matrix<T>::modify(std::function<T(const T&)> f) noexcept(false)
 	{
-		for (std::vector<T>& row : context)
+		T* x = data();
+		for (size_t i = 0; i < rows; i++)
 		{
-			for (T& field : row)
+			for (size_t j = 0; j < columns; j++)
 			{
-				field=f(field);
+				x[i * stride + j] = f(x[i * stride + j]);
 			}
 		}
 		return *this;
@@ -626,11 +1047,7 @@ namespace LinearAlgebra
 	template<typename T>
 	constexpr bool Matrix<T>::empty() const noexcept
 	{
-		for (const std::vector<T>& row : context)
-		{
-			if (!row.empty()) { return false; }
-		}
-		return true;
+		return rows == 0 || columns == 0;
 	}
 
 	template<typename T>
@@ -638,19 +1055,26 @@ namespace LinearAlgebra
 	{
 		if (rows == columns)
 		{
+			if constexpr (detail::isExactInteger<T>)
+			{
+				if (rows > 1)
+				{
+					return bareiss();
+				}
+			}
 			T det = 0;
 			switch (rows)
 			{
 			case 0:
 				return 1;
 			case 1:
-				return context[0][0];
+				return (*this)(0, 0);
 			case 2:
-				return context[0][0] * context[1][1] - context[0][1] * context[1][0];
+				return (*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0);
 			}
 			for (size_t j = 0; j < columns; j++)
 			{
-				det += context[0][j]*cofactor(0,j);
+				det += (*this)(0, j)*cofactor(0,j);
 			}
 			return det;
 		}
@@ -660,10 +1084,64 @@ namespace LinearAlgebra
 		}
 	}
 
+	template<typename T>
+	T Matrix<T>::bareiss() const noexcept(false)
+	{
+		//the minors may be negative even when the determinant of an unsigned matrix is not, so the elimination is signed
+		typedef detail::SignedWidened W;
+		std::vector<W> M(rows * rows);
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < rows; j++)
+			{
+				const T field = (*this)(i, j);
+				if constexpr (std::is_unsigned_v<T> && sizeof(T) >= sizeof(W))
+				{
+					if (field > T(std::numeric_limits<W>::max()))
+					{
+						detail::overflow();
+					}
+				}
+				M[i * rows + j] = W(field);
+			}
+		}
+		bool negative = false;
+		W previous(1);
+		for (size_t k = 0; k + 1 < rows; k++)
+		{
+			if (M[k * rows + k] == W(0))
+			{
+				size_t r = k + 1;
+				while (r < rows && M[r * rows + k] == W(0))
+				{
+					r++;
+				}
+				if (r == rows)
+				{
+					return T(0);
+				}
+				std::swap_ranges(M.begin() + k * rows, M.begin() + (k + 1) * rows, M.begin() + r * rows);
+				negative = !negative;
+			}
+			for (size_t i = k + 1; i < rows; i++)
+			{
+				for (size_t j = k + 1; j < rows; j++)
+				{
+					//division is exact, every intermediate value is a minor of the matrix
+					M[i * rows + j] = detail::checkedSub(detail::checkedMul(M[i * rows + j], M[k * rows + k]), detail::checkedMul(M[i * rows + k], M[k * rows + j])) / previous;
+				}
+			}
+			previous = M[k * rows + k];
+		}
+		W det = M[rows * rows - 1];
+		return detail::narrow<T>(negative ? detail::checkedSub(W(0), det) : det);
+	}
+
 	template<typename T>
 	constexpr T Matrix<T>::cofactor(const size_t& i, const size_t& j) const noexcept(false)
 	{
 		Matrix<T> sub(rows - 1, columns - 1);
+		T* fields = sub.context.write().data();
 		size_t it = 0;
 		for (size_t r = 0; r < rows; r++)
 		{
@@ -673,13 +1151,12 @@ namespace LinearAlgebra
 				{
 					if (c != j)
 					{
-						sub(it / (columns-1), it % (columns-1)) = context[r][c];
-						it++;
+						fields[it++] = (*this)(r, c);
 					}
 				}
 			}
 		}
-		return sub.det()*(std::pow(-1.l,i+j));
+		return (i + j) % 2 ? -sub.det() : sub.det();
 	}
 
 	template<typename T>
@@ -705,10 +1182,99 @@ namespace LinearAlgebra
 		return adjoint()/det();
 	}
 
+	//C = alpha*op(A)*op(B) + beta*C in a single pass over C, when beta is zero C is not read and gets resized if needed
+	template<typename T>
+	void gemm(const T& alpha, const Matrix<T>& A, Transpose transA, const Matrix<T>& B, Transpose transB, const T& beta, Matrix<T>& C) noexcept(false)
+	{
+		const bool ta = transA == Transpose::Yes, tb = transB == Transpose::Yes;
+		const size_t m = ta ? A.getCountColumns() : A.getCountRows();
+		const size_t k = ta ? A.getCountRows() : A.getCountColumns();
+		const size_t n = tb ? B.getCountRows() : B.getCountColumns();
+		if (k != (tb ? B.getCountColumns() : B.getCountRows()))
+		{
+			throw std::invalid_argument("Matrix multiplication undefined!");
+		}
+		if (&C == &A || &C == &B)
+		{
+			//the product must not read fields it has already overwritten, nor an operand resized as the accumulator,
+			//so it is computed aside before anything is written to C
+			Matrix<T> R(C);
+			gemm(alpha, A, transA, B, transB, beta, R);
+			C = std::move(R);
+			return;
+		}
+		if (C.getCountRows() != m || C.getCountColumns() != n)
+		{
+			if (beta != T(0))
+			{
+				throw std::invalid_argument("Accumulated matrix has to match dimensions of the product!");
+			}
+			C = Matrix<T>(m, n, Uninitialized);
+		}
+		detail::gemm(m, n, k, alpha, A.data(), A.getStride(), ta, B.data(), B.getStride(), tb, beta, C.context.write().data(), C.getStride());
+	}
+
+	//one triangle of C = alpha*op(A)*op(A)^T + beta*C, with trans set to Transpose::Yes that is A^T*A;
+	//the other triangle of C is left untouched, when beta is zero C is not read and gets resized if needed
+	template<typename T>
+	void syrk(Triangle part, const T& alpha, const Matrix<T>& A, Transpose trans, const T& beta, Matrix<T>& C) noexcept(false)
+	{
+		const bool ta = trans == Transpose::Yes;
+		const size_t n = ta ? A.getCountColumns() : A.getCountRows();
+		const size_t k = ta ? A.getCountRows() : A.getCountColumns();
+		if (&C == &A)
+		{
+			Matrix<T> R(C);
+			syrk(part, alpha, A, trans, beta, R);
+			C = std::move(R);
+			return;
+		}
+		if (C.getCountRows() != n || C.getCountColumns() != n)
+		{
+			if (beta != T(0))
+			{
+				throw std::invalid_argument("Accumulated matrix has to match dimensions of the product!");
+			}
+			C = Matrix<T>(n, n);
+		}
+		detail::syrk(part == Triangle::Lower, n, k, alpha, A.data(), A.getStride(), ta, beta, C.context.write().data(), C.getStride());
+	}
+
+	//y = alpha*op(A)*x + beta*y, when beta is zero y is not read and gets resized if needed
+	template<typename T>
+	void gemv(const T& alpha, const Matrix<T>& A, Transpose trans, const std::vector<T>& x, const T& beta, std::vector<T>& y) noexcept(false)
+	{
+		const bool ta = trans == Transpose::Yes;
+		const size_t m = ta ? A.getCountColumns() : A.getCountRows();
+		if (x.size() != (ta ? A.getCountRows() : A.getCountColumns()))
+		{
+			throw std::invalid_argument("Matrix vector multiplication undefined!");
+		}
+		if (&x == &y)
+		{
+			std::vector<T> copy(x);
+			gemv(alpha, A, trans, copy, beta, y);
+			return;
+		}
+		if (y.size() != m)
+		{
+			if (beta != T(0))
+			{
+				throw std::invalid_argument("Accumulated vector has to match dimensions of the product!");
+			}
+			y.resize(m);
+		}
+		detail::gemv(A.getCountRows(), A.getCountColumns(), alpha, A.data(), A.getStride(), ta, x.data(), beta, y.data());
+	}
+
 
 	template<typename T>
 	bool isnan(const LinearAlgebra::Matrix<T>& Mat) noexcept
 	{
+		if constexpr (!std::is_floating_point_v<T>)
+		{
+			return false;
+		}
 		for (size_t i = 0; i < Mat.getCountRows(); i++)
 		{
 			for (size_t j = 0; j < Mat.getCountColumns(); j++)
@@ -722,4 +1288,4 @@ namespace LinearAlgebra
 		}
 		return false;
 	}
-}
\ No newline at end of file
+}
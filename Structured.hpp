@@ -0,0 +1,777 @@
+#pragma once
+#include "Matrix.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	//square band matrix storing only the diagonals from -lower to +upper,
+	//each row keeps lower+upper+1 fields for columns i-lower..i+upper
+	template <typename T>
+	class BandMatrix
+	{
+		std::vector<T> context;
+		size_t n, lower, upper;
+
+		size_t index(const size_t& Row, const size_t& Col) const noexcept { return Row * (lower + upper + 1) + (Col + lower - Row); }
+
+		//returns true iff every diagonal field outweighs the rest of its row, which keeps Thomas stable without pivoting
+		bool diagonallyDominant() const noexcept;
+
+		//Thomas algorithm for tridiagonal systems, returns false when it meets a zero pivot
+		bool thomas(Matrix<T>& X) const;
+
+		//LU with partial pivoting restricted to the band, eliminates X in place and returns the determinant
+		T eliminate(Matrix<T>* X) const;
+
+	public:
+		//constructor of n x n zero band matrix with given number of sub- and superdiagonals
+		BandMatrix(const size_t& N, const size_t& Lower, const size_t& Upper);
+
+		//constructor keeping only the given band of a square matrix
+		BandMatrix(const Matrix<T>& M, const size_t& Lower, const size_t& Upper) noexcept(false);
+
+		//returns true iff field lies inside the band
+		bool inBand(const size_t& Row, const size_t& Col) const noexcept { return Col + lower >= Row && Col <= Row + upper; }
+
+		//accesses field inside the band without checks
+		T& operator()(const size_t& Row, const size_t& Col) { return context[index(Row, Col)]; }
+
+		//accesses any field, zero outside the band
+		T operator()(const size_t& Row, const size_t& Col) const { return inBand(Row, Col) ? context[index(Row, Col)] : T(0); }
+
+		//accesses field inside the band with boundary checks
+		T& at(const size_t& Row, const size_t& Col) noexcept(false);
+
+		size_t getCountRows() const noexcept { return n; }
+		size_t getCountColumns() const noexcept { return n; }
+		size_t getLowerBandwidth() const noexcept { return lower; }
+		size_t getUpperBandwidth() const noexcept { return upper; }
+
+		//multiplication touching only the band
+		Matrix<T> operator*(const Matrix<T>& B) const noexcept(false);
+
+		//solves A*X = B, diagonally dominant tridiagonal systems use the Thomas algorithm, the others banded LU
+		Matrix<T> solve(const Matrix<T>& B) const noexcept(false);
+
+		//determinant in O(n) for fixed bandwidth
+		T det() const;
+
+		Matrix<T> toMatrix() const;
+	};
+
+	//square triangular matrix packed row after row, only the stored triangle is kept
+	template <typename T>
+	class TriangularMatrix
+	{
+		std::vector<T> context;
+		size_t n;
+		Triangle part;
+		static inline const T zero = T(0);
+
+		size_t index(const size_t& Row, const size_t& Col) const noexcept { return part == Triangle::Lower ? Row * (Row + 1) / 2 + Col : Row * n - Row * (Row - 1) / 2 + (Col - Row); }
+
+	public:
+		//constructor of n x n zero triangular matrix
+		TriangularMatrix(const size_t& N, Triangle Part);
+
+		//constructor keeping the given triangle of a square matrix
+		TriangularMatrix(const Matrix<T>& M, Triangle Part) noexcept(false);
+
+		//returns true iff field belongs to the stored triangle
+		bool inTriangle(const size_t& Row, const size_t& Col) const noexcept { return part == Triangle::Lower ? Col <= Row : Col >= Row; }
+
+		//accesses field of the stored triangle without checks
+		T& operator()(const size_t& Row, const size_t& Col) { return context[index(Row, Col)]; }
+
+		//accesses any field, zero outside the stored triangle
+		const T& operator()(const size_t& Row, const size_t& Col) const { return inTriangle(Row, Col) ? context[index(Row, Col)] : zero; }
+
+		//accesses field of the stored triangle with boundary checks
+		T& at(const size_t& Row, const size_t& Col) noexcept(false);
+
+		size_t getCountRows() const noexcept { return n; }
+		size_t getCountColumns() const noexcept { return n; }
+		Triangle getPart() const noexcept { return part; }
+
+		//multiplication touching only the stored triangle
+		Matrix<T> operator*(const Matrix<T>& B) const noexcept(false);
+
+		//solves A*X = B by forward or back substitution
+		Matrix<T> solve(const Matrix<T>& B) const noexcept(false);
+
+		//determinant as the product of the diagonal
+		T det() const noexcept;
+
+		Matrix<T> toMatrix() const;
+	};
+
+	//square symmetric matrix packing the lower triangle row after row (n(n+1)/2 fields)
+	template <typename T>
+	class SymmetricMatrix
+	{
+		std::vector<T> context;
+		size_t n;
+
+		size_t index(const size_t& Row, const size_t& Col) const noexcept { return Row >= Col ? Row * (Row + 1) / 2 + Col : Col * (Col + 1) / 2 + Row; }
+
+		//Bunch-Kaufman factorization P*A*P^T = L*D*L^T with symmetric pivoting, D has 1x1 and 2x2 blocks;
+		//F holds L below the diagonal and the diagonal of D, E[k] is the nonzero off-diagonal of a 2x2 block
+		//at k, k+1 (zero for 1x1 blocks), row k was swapped with pivots[k]; returns false for singular matrix
+		bool factorize(std::vector<T>& F, std::vector<T>& E, std::vector<size_t>& pivots) const;
+
+		//swaps rows and columns a and b of the packed matrix F
+		void swapSymmetric(std::vector<T>& F, const size_t& a, const size_t& b) const;
+
+	public:
+		//constructor of n x n zero symmetric matrix
+		explicit SymmetricMatrix(const size_t& N);
+
+		//constructor taking the lower triangle of a square matrix
+		explicit SymmetricMatrix(const Matrix<T>& M) noexcept(false);
+
+		//accesses field (i,j), the same as (j,i), without boundary checks
+		T& operator()(const size_t& Row, const size_t& Col) { return context[index(Row, Col)]; }
+
+		const T& operator()(const size_t& Row, const size_t& Col) const { return context[index(Row, Col)]; }
+
+		//accesses field with boundary checks
+		T& at(const size_t& Row, const size_t& Col) noexcept(false);
+
+		size_t getCountRows() const noexcept { return n; }
+		size_t getCountColumns() const noexcept { return n; }
+
+		//multiplication reading every stored field once
+		Matrix<T> operator*(const Matrix<T>& B) const noexcept(false);
+
+		//solves A*X = B using the Bunch-Kaufman factorization, stable for indefinite matrices as well
+		Matrix<T> solve(const Matrix<T>& B) const noexcept(false);
+
+		//determinant as the product of the blocks of D
+		T det() const;
+
+		Matrix<T> toMatrix() const;
+	};
+
+	template <typename T>
+	BandMatrix<T>::BandMatrix(const size_t& N, const size_t& Lower, const size_t& Upper) :context(N * (Lower + Upper + 1), T(0)), n(N), lower(Lower), upper(Upper)
+	{
+	}
+
+	template <typename T>
+	BandMatrix<T>::BandMatrix(const Matrix<T>& M, const size_t& Lower, const size_t& Upper) noexcept(false) :BandMatrix(M.getCountRows(), Lower, Upper)
+	{
+		if (M.getCountRows() != M.getCountColumns())
+		{
+			throw std::domain_error("Band matrix has to be square!");
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = i > lower ? i - lower : 0; j < n && j <= i + upper; j++)
+			{
+				(*this)(i, j) = M(i, j);
+			}
+		}
+	}
+
+	template <typename T>
+	T& BandMatrix<T>::at(const size_t& Row, const size_t& Col) noexcept(false)
+	{
+		if (Row >= n || Col >= n || !inBand(Row, Col))
+		{
+			throw std::out_of_range("Field lies outside of the band!");
+		}
+		return context[index(Row, Col)];
+	}
+
+	template <typename T>
+	Matrix<T> BandMatrix<T>::operator*(const Matrix<T>& B) const noexcept(false)
+	{
+		if (B.getCountRows() != n)
+		{
+			throw std::invalid_argument("Matrix multiplication undefined!");
+		}
+		Matrix<T> A(n, B.getCountColumns());
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t k = i > lower ? i - lower : 0; k < n && k <= i + upper; k++)
+			{
+				const T a = context[index(i, k)];
+				for (size_t j = 0; j < B.getCountColumns(); j++)
+				{
+					A(i, j) += a * B(k, j);
+				}
+			}
+		}
+		return A;
+	}
+
+	template <typename T>
+	bool BandMatrix<T>::diagonallyDominant() const noexcept
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			T offDiagonal = T(0);
+			for (size_t k = i > lower ? i - lower : 0; k < n && k <= i + upper; k++)
+			{
+				if (k != i)
+				{
+					offDiagonal += std::abs(context[index(i, k)]);
+				}
+			}
+			if (std::abs(context[index(i, i)]) < offDiagonal)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	bool BandMatrix<T>::thomas(Matrix<T>& X) const
+	{
+		std::vector<T> c(n, T(0));
+		for (size_t i = 0; i < n; i++)
+		{
+			T pivot = (*this)(i, i) - (i ? (*this)(i, i - 1) * c[i - 1] : T(0));
+			if (pivot == T(0))
+			{
+				return false;
+			}
+			c[i] = i + 1 < n ? (*this)(i, i + 1) / pivot : T(0);
+			for (size_t j = 0; j < X.getCountColumns(); j++)
+			{
+				X(i, j) = (X(i, j) - (i ? (*this)(i, i - 1) * X(i - 1, j) : T(0))) / pivot;
+			}
+		}
+		for (size_t i = n > 1 ? n - 1 : 0; i-- > 0;)
+		{
+			for (size_t j = 0; j < X.getCountColumns(); j++)
+			{
+				X(i, j) -= c[i] * X(i + 1, j);
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	T BandMatrix<T>::eliminate(Matrix<T>* X) const
+	{
+		//working rows cover columns i-lower..i+lower+upper to make room for the fill-in caused by pivoting
+		const size_t width = 2 * lower + upper + 1;
+		std::vector<T> W(n * width, T(0));
+		auto field = [&](size_t Row, size_t Col) -> T& { return W[Row * width + (Col + lower - Row)]; };
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = i > lower ? i - lower : 0; j < n && j <= i + upper; j++)
+			{
+				field(i, j) = context[index(i, j)];
+			}
+		}
+		T det(1);
+		for (size_t k = 0; k < n; k++)
+		{
+			const size_t last = std::min(n - 1, k + lower);
+			const size_t reach = std::min(n - 1, k + lower + upper);
+			size_t p = k;
+			for (size_t r = k + 1; r <= last; r++)
+			{
+				if (std::abs(field(r, k)) > std::abs(field(p, k)))
+				{
+					p = r;
+				}
+			}
+			if (field(p, k) == T(0))
+			{
+				return T(0);
+			}
+			if (p != k)
+			{
+				for (size_t c = k; c <= reach; c++)
+				{
+					std::swap(field(k, c), field(p, c));
+				}
+				if (X)
+				{
+					for (size_t j = 0; j < X->getCountColumns(); j++)
+					{
+						std::swap((*X)(k, j), (*X)(p, j));
+					}
+				}
+				det = -det;
+			}
+			const T pivot = field(k, k);
+			det *= pivot;
+			for (size_t r = k + 1; r <= last; r++)
+			{
+				const T l = field(r, k) / pivot;
+				if (l == T(0))
+				{
+					continue;
+				}
+				field(r, k) = T(0);
+				for (size_t c = k + 1; c <= reach; c++)
+				{
+					field(r, c) -= l * field(k, c);
+				}
+				if (X)
+				{
+					for (size_t j = 0; j < X->getCountColumns(); j++)
+					{
+						(*X)(r, j) -= l * (*X)(k, j);
+					}
+				}
+			}
+		}
+		if (X)
+		{
+			for (size_t i = n; i-- > 0;)
+			{
+				const size_t reach = std::min(n - 1, i + lower + upper);
+				for (size_t j = 0; j < X->getCountColumns(); j++)
+				{
+					T s = (*X)(i, j);
+					for (size_t c = i + 1; c <= reach; c++)
+					{
+						s -= field(i, c) * (*X)(c, j);
+					}
+					(*X)(i, j) = s / field(i, i);
+				}
+			}
+		}
+		return det;
+	}
+
+	template <typename T>
+	Matrix<T> BandMatrix<T>::solve(const Matrix<T>& B) const noexcept(false)
+	{
+		if (B.getCountRows() != n)
+		{
+			throw std::invalid_argument("Right hand side has to have as many rows as the band matrix!");
+		}
+		Matrix<T> X(B);
+		if (lower <= 1 && upper <= 1 && diagonallyDominant() && thomas(X))
+		{
+			return X;
+		}
+		X = B;
+		if (eliminate(&X) == T(0))
+		{
+			throw std::domain_error("System with singular band matrix has no unique solution!");
+		}
+		return X;
+	}
+
+	template <typename T>
+	T BandMatrix<T>::det() const
+	{
+		if (lower == 0 || upper == 0)
+		{
+			T det(1);
+			for (size_t i = 0; i < n; i++)
+			{
+				det *= context[index(i, i)];
+			}
+			return det;
+		}
+		if (lower == 1 && upper == 1)
+		{
+			//continuant recurrence f(i) = a(i)f(i-1) - b(i-1)c(i-1)f(i-2)
+			T previous(1), current(1);
+			for (size_t i = 0; i < n; i++)
+			{
+				T next = (*this)(i, i) * current - (i ? (*this)(i, i - 1) * (*this)(i - 1, i) * previous : T(0));
+				previous = current;
+				current = next;
+			}
+			return current;
+		}
+		return eliminate(nullptr);
+	}
+
+	template <typename T>
+	Matrix<T> BandMatrix<T>::toMatrix() const
+	{
+		Matrix<T> M(n, n);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = i > lower ? i - lower : 0; j < n && j <= i + upper; j++)
+			{
+				M(i, j) = context[index(i, j)];
+			}
+		}
+		return M;
+	}
+
+	template <typename T>
+	TriangularMatrix<T>::TriangularMatrix(const size_t& N, Triangle Part) :context(N * (N + 1) / 2, T(0)), n(N), part(Part)
+	{
+	}
+
+	template <typename T>
+	TriangularMatrix<T>::TriangularMatrix(const Matrix<T>& M, Triangle Part) noexcept(false) :TriangularMatrix(M.getCountRows(), Part)
+	{
+		if (M.getCountRows() != M.getCountColumns())
+		{
+			throw std::domain_error("Triangular matrix has to be square!");
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = part == Triangle::Lower ? 0 : i; j < (part == Triangle::Lower ? i + 1 : n); j++)
+			{
+				(*this)(i, j) = M(i, j);
+			}
+		}
+	}
+
+	template <typename T>
+	T& TriangularMatrix<T>::at(const size_t& Row, const size_t& Col) noexcept(false)
+	{
+		if (Row >= n || Col >= n || !inTriangle(Row, Col))
+		{
+			throw std::out_of_range("Field lies outside of the stored triangle!");
+		}
+		return context[index(Row, Col)];
+	}
+
+	template <typename T>
+	Matrix<T> TriangularMatrix<T>::operator*(const Matrix<T>& B) const noexcept(false)
+	{
+		if (B.getCountRows() != n)
+		{
+			throw std::invalid_argument("Matrix multiplication undefined!");
+		}
+		Matrix<T> A(n, B.getCountColumns());
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t k = part == Triangle::Lower ? 0 : i; k < (part == Triangle::Lower ? i + 1 : n); k++)
+			{
+				const T a = context[index(i, k)];
+				for (size_t j = 0; j < B.getCountColumns(); j++)
+				{
+					A(i, j) += a * B(k, j);
+				}
+			}
+		}
+		return A;
+	}
+
+	template <typename T>
+	Matrix<T> TriangularMatrix<T>::solve(const Matrix<T>& B) const noexcept(false)
+	{
+		if (B.getCountRows() != n)
+		{
+			throw std::invalid_argument("Right hand side has to have as many rows as the triangular matrix!");
+		}
+		Matrix<T> X(B);
+		for (size_t step = 0; step < n; step++)
+		{
+			//forward substitution for lower, back substitution for upper triangle
+			const size_t i = part == Triangle::Lower ? step : n - 1 - step;
+			const T pivot = context[index(i, i)];
+			if (pivot == T(0))
+			{
+				throw std::domain_error("System with singular triangular matrix has no unique solution!");
+			}
+			for (size_t k = part == Triangle::Lower ? 0 : i + 1; k < (part == Triangle::Lower ? i : n); k++)
+			{
+				const T a = context[index(i, k)];
+				for (size_t j = 0; j < X.getCountColumns(); j++)
+				{
+					X(i, j) -= a * X(k, j);
+				}
+			}
+			for (size_t j = 0; j < X.getCountColumns(); j++)
+			{
+				X(i, j) /= pivot;
+			}
+		}
+		return X;
+	}
+
+	template <typename T>
+	T TriangularMatrix<T>::det() const noexcept
+	{
+		T det(1);
+		for (size_t i = 0; i < n; i++)
+		{
+			det *= context[index(i, i)];
+		}
+		return det;
+	}
+
+	template <typename T>
+	Matrix<T> TriangularMatrix<T>::toMatrix() const
+	{
+		Matrix<T> M(n, n);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = part == Triangle::Lower ? 0 : i; j < (part == Triangle::Lower ? i + 1 : n); j++)
+			{
+				M(i, j) = context[index(i, j)];
+			}
+		}
+		return M;
+	}
+
+	template <typename T>
+	SymmetricMatrix<T>::SymmetricMatrix(const size_t& N) :context(N * (N + 1) / 2, T(0)), n(N)
+	{
+	}
+
+	template <typename T>
+	SymmetricMatrix<T>::SymmetricMatrix(const Matrix<T>& M) noexcept(false) :SymmetricMatrix(M.getCountRows())
+	{
+		if (M.getCountRows() != M.getCountColumns())
+		{
+			throw std::domain_error("Symmetric matrix has to be square!");
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = 0; j <= i; j++)
+			{
+				(*this)(i, j) = M(i, j);
+			}
+		}
+	}
+
+	template <typename T>
+	T& SymmetricMatrix<T>::at(const size_t& Row, const size_t& Col) noexcept(false)
+	{
+		if (Row >= n || Col >= n)
+		{
+			throw std::out_of_range("Matrix field out of range!");
+		}
+		return context[index(Row, Col)];
+	}
+
+	template <typename T>
+	Matrix<T> SymmetricMatrix<T>::operator*(const Matrix<T>& B) const noexcept(false)
+	{
+		if (B.getCountRows() != n)
+		{
+			throw std::invalid_argument("Matrix multiplication undefined!");
+		}
+		Matrix<T> A(n, B.getCountColumns());
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t k = 0; k <= i; k++)
+			{
+				const T a = context[index(i, k)];
+				for (size_t j = 0; j < B.getCountColumns(); j++)
+				{
+					A(i, j) += a * B(k, j);
+				}
+				if (k != i)
+				{
+					for (size_t j = 0; j < B.getCountColumns(); j++)
+					{
+						A(k, j) += a * B(i, j);
+					}
+				}
+			}
+		}
+		return A;
+	}
+
+	template <typename T>
+	void SymmetricMatrix<T>::swapSymmetric(std::vector<T>& F, const size_t& a, const size_t& b) const
+	{
+		//the field (a,b) maps onto itself, the others swap with their mirror
+		for (size_t j = 0; j < n; j++)
+		{
+			if (j != a && j != b)
+			{
+				std::swap(F[index(a, j)], F[index(b, j)]);
+			}
+		}
+		std::swap(F[index(a, a)], F[index(b, b)]);
+	}
+
+	template <typename T>
+	bool SymmetricMatrix<T>::factorize(std::vector<T>& F, std::vector<T>& E, std::vector<size_t>& pivots) const
+	{
+		//threshold bounding the growth of the fields, (1+sqrt(17))/8
+		const T alpha = (T(1) + std::sqrt(T(17))) / T(8);
+		F = context;
+		E.assign(n, T(0));
+		pivots.resize(n);
+		size_t k = 0;
+		while (k < n)
+		{
+			const T absDiagonal = std::abs(F[index(k, k)]);
+			size_t r = k;
+			T columnMax(0);
+			for (size_t i = k + 1; i < n; i++)
+			{
+				if (std::abs(F[index(i, k)]) > columnMax)
+				{
+					columnMax = std::abs(F[index(i, k)]);
+					r = i;
+				}
+			}
+			if (absDiagonal == T(0) && columnMax == T(0))
+			{
+				return false;
+			}
+			size_t pivot = k;
+			bool block = false;
+			if (absDiagonal < alpha * columnMax)
+			{
+				T rowMax(0);
+				for (size_t j = k; j < n; j++)
+				{
+					if (j != r)
+					{
+						rowMax = std::max(rowMax, std::abs(F[index(r, j)]));
+					}
+				}
+				if (absDiagonal * rowMax < alpha * columnMax * columnMax)
+				{
+					pivot = r;
+					block = std::abs(F[index(r, r)]) < alpha * rowMax;
+				}
+			}
+			//1x1 pivot moves r to k, 2x2 pivot moves r to k+1 next to k
+			const size_t last = block ? k + 1 : k;
+			pivots[k] = k;
+			pivots[last] = pivot;
+			if (pivot != last)
+			{
+				swapSymmetric(F, last, pivot);
+			}
+			if (!block)
+			{
+				const T d = F[index(k, k)];
+				for (size_t j = k + 1; j < n; j++)
+				{
+					const T l = F[index(j, k)] / d;
+					for (size_t i = j; i < n; i++)
+					{
+						F[index(i, j)] -= F[index(i, k)] * l;
+					}
+					F[index(j, k)] = l;
+				}
+			}
+			else
+			{
+				//inverse of the block [a b; b c] applied through scaled quotients, which avoids overflow in ac-b^2
+				const T b = F[index(k + 1, k)];
+				const T a = F[index(k, k)] / b, c = F[index(k + 1, k + 1)] / b;
+				const T scale = T(1) / (a * c - T(1)) / b;
+				for (size_t j = k + 2; j < n; j++)
+				{
+					const T lk = scale * (c * F[index(j, k)] - F[index(j, k + 1)]);
+					const T lk1 = scale * (a * F[index(j, k + 1)] - F[index(j, k)]);
+					for (size_t i = j; i < n; i++)
+					{
+						F[index(i, j)] -= F[index(i, k)] * lk + F[index(i, k + 1)] * lk1;
+					}
+					F[index(j, k)] = lk;
+					F[index(j, k + 1)] = lk1;
+				}
+				E[k] = b;
+				F[index(k + 1, k)] = T(0);
+			}
+			k = last + 1;
+		}
+		return true;
+	}
+
+	template <typename T>
+	Matrix<T> SymmetricMatrix<T>::solve(const Matrix<T>& B) const noexcept(false)
+	{
+		if (B.getCountRows() != n)
+		{
+			throw std::invalid_argument("Right hand side has to have as many rows as the symmetric matrix!");
+		}
+		std::vector<T> F, E;
+		std::vector<size_t> pivots;
+		if (!factorize(F, E, pivots))
+		{
+			throw std::domain_error("System with singular symmetric matrix has no unique solution!");
+		}
+		Matrix<T> X(B);
+		for (size_t j = 0; j < X.getCountColumns(); j++)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				std::swap(X(i, j), X(pivots[i], j));
+			}
+			for (size_t i = 0; i < n; i++)
+			{
+				for (size_t k = 0; k < i; k++)
+				{
+					X(i, j) -= F[index(i, k)] * X(k, j);
+				}
+			}
+			for (size_t i = 0; i < n; i++)
+			{
+				if (E[i] == T(0))
+				{
+					X(i, j) /= F[index(i, i)];
+					continue;
+				}
+				const T b = E[i], a = F[index(i, i)] / b, c = F[index(i + 1, i + 1)] / b;
+				const T x0 = X(i, j) / b, x1 = X(i + 1, j) / b;
+				const T scale = T(1) / (a * c - T(1));
+				X(i, j) = scale * (c * x0 - x1);
+				X(i + 1, j) = scale * (a * x1 - x0);
+				i++;
+			}
+			for (size_t i = n; i-- > 0;)
+			{
+				for (size_t k = i + 1; k < n; k++)
+				{
+					X(i, j) -= F[index(k, i)] * X(k, j);
+				}
+			}
+			for (size_t i = n; i-- > 0;)
+			{
+				std::swap(X(i, j), X(pivots[i], j));
+			}
+		}
+		return X;
+	}
+
+	template <typename T>
+	T SymmetricMatrix<T>::det() const
+	{
+		std::vector<T> F, E;
+		std::vector<size_t> pivots;
+		if (!factorize(F, E, pivots))
+		{
+			return T(0);
+		}
+		//the symmetric permutation does not change the determinant
+		T det(1);
+		for (size_t k = 0; k < n; k++)
+		{
+			if (E[k] == T(0))
+			{
+				det *= F[index(k, k)];
+				continue;
+			}
+			det *= F[index(k, k)] * F[index(k + 1, k + 1)] - E[k] * E[k];
+			k++;
+		}
+		return det;
+	}
+
+	template <typename T>
+	Matrix<T> SymmetricMatrix<T>::toMatrix() const
+	{
+		Matrix<T> M(n, n, Uninitialized);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (size_t j = 0; j < n; j++)
+			{
+				M(i, j) = context[index(i, j)];
+			}
+		}
+		return M;
+	}
+}
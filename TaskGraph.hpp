@@ -0,0 +1,201 @@
+#pragma once
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	namespace detail
+	{
+		//state shared by a task handle, the job computing its value and the tasks depending on it
+		template <typename R>
+		struct TaskNode
+		{
+			std::mutex mutex;
+			std::condition_variable finished;
+			bool done = false;
+			std::optional<R> value;
+			std::exception_ptr error;
+			std::vector<std::function<void()>> continuations;
+
+			//runs continuation once the node is finished, immediately if it already is
+			void then(std::function<void()> continuation)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!done)
+					{
+						continuations.push_back(std::move(continuation));
+						return;
+					}
+				}
+				continuation();
+			}
+
+			//publishes value (or error) and releases the dependent tasks
+			void finish()
+			{
+				std::vector<std::function<void()>> pending;
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					done = true;
+					pending.swap(continuations);
+				}
+				finished.notify_all();
+				for (std::function<void()>& continuation : pending)
+				{
+					continuation();
+				}
+			}
+		};
+	}
+
+	//handle to the value of a node in a task graph, copies refer to the same node
+	template <typename R>
+	class Task
+	{
+		static_assert(!std::is_void_v<R>, "Task has to produce a value!");
+		std::shared_ptr<detail::TaskNode<R>> node;
+
+	public:
+		Task() = default;
+
+		explicit Task(std::shared_ptr<detail::TaskNode<R>> state) :node(std::move(state)) {}
+
+		//shared state of the node, used when chaining further tasks onto it
+		const std::shared_ptr<detail::TaskNode<R>>& state() const noexcept { return node; }
+
+		bool valid() const noexcept { return node != nullptr; }
+
+		//returns true iff value (or exception) is already available
+		bool ready() const
+		{
+			std::lock_guard<std::mutex> lock(node->mutex);
+			return node->done;
+		}
+
+		//blocks until the node is finished
+		void wait() const
+		{
+			std::unique_lock<std::mutex> lock(node->mutex);
+			node->finished.wait(lock, [this]() { return node->done; });
+		}
+
+		//blocks until the node is finished, rethrows exception raised by it or by any of its dependencies
+		const R& get() const noexcept(false)
+		{
+			wait();
+			if (node->error)
+			{
+				std::rethrow_exception(node->error);
+			}
+			return *node->value;
+		}
+	};
+
+	//task which is already finished with given value
+	template <typename R>
+	Task<R> ready(R value)
+	{
+		auto node = std::make_shared<detail::TaskNode<R>>();
+		node->value.emplace(std::move(value));
+		node->done = true;
+		return Task<R>(node);
+	}
+
+	//adds a node computing f(deps.get()...) to the graph, the job is queued on pool once all dependencies finish,
+	//independent nodes run concurrently; an exception of any dependency is forwarded without calling f
+	template <typename F, typename... Deps>
+	Task<std::invoke_result_t<F&, const Deps&...>> schedule(ThreadPool& pool, F f, const Task<Deps>&... deps)
+	{
+		typedef std::invoke_result_t<F&, const Deps&...> R;
+		auto node = std::make_shared<detail::TaskNode<R>>();
+		auto inputs = std::make_tuple(deps.state()...);
+		auto job = std::make_shared<std::function<void()>>([node, inputs, f]() mutable
+		{
+			try
+			{
+				std::apply([&](const auto&... input)
+				{
+					std::exception_ptr failure;
+					((failure = failure ? failure : input->error), ...);
+					if (failure)
+					{
+						std::rethrow_exception(failure);
+					}
+					node->value.emplace(std::invoke(f, *input->value...));
+				}, inputs);
+			}
+			catch (...)
+			{
+				node->error = std::current_exception();
+			}
+			node->finish();
+		});
+		//one count per dependency plus one released after all the continuations are registered
+		auto pending = std::make_shared<std::atomic<size_t>>(sizeof...(Deps) + 1);
+		ThreadPool* executor = &pool;
+		auto release = [pending, executor, job]()
+		{
+			if (pending->fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				executor->enqueue([job]() { (*job)(); });
+			}
+		};
+		std::apply([&](const auto&... input) { (input->then(release), ...); }, inputs);
+		release();
+		return Task<R>(node);
+	}
+
+	//adds a node to the graph executed on the library's shared pool
+	template <typename F, typename... Deps>
+	Task<std::invoke_result_t<F&, const Deps&...>> schedule(F f, const Task<Deps>&... deps)
+	{
+		return schedule(ThreadPool::shared(), std::move(f), deps...);
+	}
+
+	template <typename T>
+	Task<Matrix<T>> operator+(const Task<Matrix<T>>& A, const Task<Matrix<T>>& B)
+	{
+		return schedule([](const Matrix<T>& a, const Matrix<T>& b) { return a + b; }, A, B);
+	}
+
+	template <typename T>
+	Task<Matrix<T>> operator-(const Task<Matrix<T>>& A, const Task<Matrix<T>>& B)
+	{
+		return schedule([](const Matrix<T>& a, const Matrix<T>& b) { return a - b; }, A, B);
+	}
+
+	template <typename T>
+	Task<Matrix<T>> operator*(const Task<Matrix<T>>& A, const Task<Matrix<T>>& B)
+	{
+		return schedule([](const Matrix<T>& a, const Matrix<T>& b) { return a * b; }, A, B);
+	}
+
+	template <typename T>
+	Task<Matrix<T>> operator*(const Task<Matrix<T>>& A, const T& C)
+	{
+		return schedule([C](const Matrix<T>& a) { return a * C; }, A);
+	}
+
+	template <typename T>
+	Task<Matrix<T>> transposed(const Task<Matrix<T>>& A)
+	{
+		return schedule([](const Matrix<T>& a) { return a.transposed(); }, A);
+	}
+
+	template <typename T>
+	Task<Matrix<T>> inverse(const Task<Matrix<T>>& A)
+	{
+		return schedule([](const Matrix<T>& a) { return a.inverse(); }, A);
+	}
+}
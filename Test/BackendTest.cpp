@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "../Decomposition.hpp"
+#include "MatrixFixture.hpp"
+
+struct BackendTest : public MatrixFixture<double>
+{
+	LinearAlgebra::Backend original;
+	virtual void SetUp() override
+	{
+		MatrixFixture::SetUp();
+		original = LinearAlgebra::getBackend();
+	}
+	virtual void TearDown() override
+	{
+		LinearAlgebra::setBackend(original);
+	}
+};
+
+TEST_F(BackendTest, BackendSelectionTest)
+{
+	using namespace LinearAlgebra;
+
+	given(std::string("Library built ") + (blasAvailable() ? "with" : "without") + " BLAS, running on the " + (getBackend() == Backend::Blas ? "BLAS" : "built-in") + " backend");
+
+	then("Built-in backend can always be selected");
+	ASSERT_NO_THROW(setBackend(Backend::Builtin));
+	EXPECT_EQ(getBackend(), Backend::Builtin);
+
+	then("BLAS backend can be selected iff the library was built against it");
+	if (blasAvailable())
+	{
+		EXPECT_NO_THROW(setBackend(Backend::Blas));
+		EXPECT_EQ(getBackend(), Backend::Blas);
+	}
+	else
+	{
+		EXPECT_THROW(setBackend(Backend::Blas), std::invalid_argument);
+		EXPECT_EQ(getBackend(), Backend::Builtin);
+	}
+}
+
+TEST_F(BackendTest, BackendsAgreeTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Random 70x90 matrix A, 90x40 matrix B and 40x40 accumulator C:");
+	Mat A = randomMatrix(70, 90), B = randomMatrix(90, 40), C = randomMatrix(40, 40);
+
+	then("Products, gemm, syrk and decompositions are the same on every available backend");
+	std::vector<Backend> backends = { Backend::Builtin };
+	if (blasAvailable())
+	{
+		backends.push_back(Backend::Blas);
+	}
+	std::vector<Mat> results;
+	std::vector<std::vector<double>> spectra;
+	for (Backend backend : backends)
+	{
+		setBackend(backend);
+		Mat G = C, S = C;
+		gemm(0.5, B, Transpose::Yes, B, Transpose::No, 2.0, G);
+		syrk(Triangle::Upper, 1.0, B, Transpose::Yes, 0.0, S);
+		results.push_back(A * B);
+		results.push_back(G);
+		results.push_back(S);
+		spectra.push_back(svd(A).S);
+	}
+	for (size_t b = 1; b < backends.size(); b++)
+	{
+		for (size_t r = 0; r < 3; r++)
+		{
+			EXPECT_LT(maxAbsDifference(results[r], results[3 * b + r]), 1e-9);
+		}
+		for (size_t i = 0; i < spectra[0].size(); i++)
+		{
+			EXPECT_NEAR(spectra[0][i], spectra[b][i], 1e-9 * spectra[0][0]);
+		}
+	}
+
+	then("Element types without a vendor kernel stay on the generic templates");
+	LinearAlgebra::Matrix<long double> L(3, 3, []() { return 1.l; });
+	EXPECT_EQ((L * L)(2, 1), 3.l);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../Decomposition.hpp"
+#include "MatrixFixture.hpp"
+
+struct DecompositionTest : public MatrixFixture<double>
+{
+	Mat randomSymmetric(const size_t& n)
+	{
+		Mat A = randomMatrix(n, n);
+		return A + A.transposed();
+	}
+};
+
+TEST_F(DecompositionTest, SymmetricEigenTest)
+{
+	using namespace LinearAlgebra;
+
+	given("8x8 random symmetric matrix A:");
+	Mat A = randomSymmetric(8);
+	A.print();
+
+	then("A = V * diag(values) * V^T and V is orthogonal");
+	EigenDecomposition<double> E;
+	ASSERT_NO_THROW(E = symmetricEigen(A));
+	ASSERT_EQ(E.values.size(), 8u);
+	EXPECT_LT(maxAbsDifference(E.vectors * LinearAlgebra::diagonal(E.values) * E.vectors.transposed(), A), 1e-9);
+	Mat id(8, 8, []() { return 0.0; });
+	for (size_t i = 0; i < 8; i++)
+	{
+		id(i, i) = 1.0;
+	}
+	EXPECT_LT(maxAbsDifference(E.vectors.transposed() * E.vectors, id), 1e-12);
+
+	then("Eigenvalues are sorted in descending order");
+	EXPECT_TRUE(std::is_sorted(E.values.rbegin(), E.values.rend()));
+
+	then("Eigenvalues alone agree with the full decomposition");
+	EigenDecomposition<double> valuesOnly = symmetricEigen(A, false);
+	ASSERT_EQ(valuesOnly.values.size(), 8u);
+	EXPECT_TRUE(valuesOnly.vectors.empty());
+	for (size_t i = 0; i < 8; i++)
+	{
+		EXPECT_NEAR(valuesOnly.values[i], E.values[i], 1e-10);
+	}
+
+	then("Eigendecomposition of non square matrix is undefined");
+	EXPECT_THROW(symmetricEigen(randomMatrix(3, 4)), std::domain_error);
+}
+
+TEST_F(DecompositionTest, SingularValueDecompositionTest)
+{
+	using namespace LinearAlgebra;
+
+	for (auto [m, n] : { std::pair<size_t, size_t>{ 7, 5 }, { 5, 7 }, { 6, 6 } })
+	{
+		given(std::to_string(m) + "x" + std::to_string(n) + " random matrix A:");
+		Mat A = randomMatrix(m, n);
+		A.print();
+
+		then("A = U * diag(S) * V^T with singular values in descending order");
+		SingularValueDecomposition<double> D;
+		ASSERT_NO_THROW(D = svd(A));
+		ASSERT_EQ(D.S.size(), std::min(m, n));
+		EXPECT_LT(maxAbsDifference(D.U * LinearAlgebra::diagonal(D.S) * D.V.transposed(), A), 1e-9);
+		EXPECT_TRUE(std::is_sorted(D.S.rbegin(), D.S.rend()));
+	}
+}
+
+TEST_F(DecompositionTest, TopKMethodsTest)
+{
+	using namespace LinearAlgebra;
+
+	given("40x40 symmetric matrix with known dominant spectrum:");
+	Mat Q = svd(randomMatrix(40, 40)).U;
+	std::vector<double> spectrum(40);
+	for (size_t i = 0; i < 40; i++)
+	{
+		spectrum[i] = i < 3 ? 100.0 - 10.0 * i : 1.0 / (i + 1);
+	}
+	Mat A = Q * LinearAlgebra::diagonal(spectrum) * Q.transposed();
+
+	then("Power iteration and Lanczos recover the three leading eigenpairs");
+	for (const EigenDecomposition<double>& E : { powerIteration(A, 3), lanczos(A, 3) })
+	{
+		ASSERT_EQ(E.values.size(), 3u);
+		for (size_t i = 0; i < 3; i++)
+		{
+			EXPECT_NEAR(E.values[i], spectrum[i], 1e-6);
+			Mat v(40, 1);
+			for (size_t r = 0; r < 40; r++)
+			{
+				v(r, 0) = E.vectors(r, i);
+			}
+			EXPECT_LT(maxAbsDifference(A * v, v * E.values[i]), 1e-4);
+		}
+	}
+
+	given("Symmetric 30x30 matrix of rank 2:");
+	Mat P = randomMatrix(30, 2);
+	Mat R = P * P.transposed();
+
+	then("Lanczos restarts after exhausting the Krylov subspace and still finds both eigenpairs");
+	EigenDecomposition<double> exhausted = lanczos(R, 2, 8);
+	EigenDecomposition<double> reference = symmetricEigen(R);
+	for (size_t i = 0; i < 2; i++)
+	{
+		EXPECT_NEAR(exhausted.values[i], reference.values[i], 1e-8 * reference.values[0]);
+	}
+
+	given("Rank 3 product of random 30x3 and 3x20 matrices:");
+	Mat B = randomMatrix(30, 3) * randomMatrix(3, 20);
+
+	then("Randomized SVD agrees with the dense SVD on the leading singular values");
+	SingularValueDecomposition<double> exact = svd(B);
+	SingularValueDecomposition<double> sketch = randomizedSVD(B, 3);
+	for (size_t i = 0; i < 3; i++)
+	{
+		EXPECT_NEAR(sketch.S[i], exact.S[i], 1e-8 * exact.S[0]);
+	}
+	EXPECT_LT(maxAbsDifference(sketch.U * LinearAlgebra::diagonal(sketch.S) * sketch.V.transposed(), B), 1e-8 * exact.S[0]);
+}
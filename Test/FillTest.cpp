@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "../Fill.hpp"
+#include "MatrixFixture.hpp"
+
+struct FillTest : public MatrixFixture<double>
+{
+};
+
+TEST_F(FillTest, PhiloxTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Known answer vectors of Philox4x32-10:");
+	typedef Philox4x32::Counter Counter;
+
+	then("Generator reproduces them");
+	EXPECT_EQ(Philox4x32(0)({ 0, 0, 0, 0 }), (Counter{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+	EXPECT_EQ(Philox4x32(0xffffffffffffffffull)({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }), (Counter{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+	EXPECT_EQ(Philox4x32(0x299f31d0a4093822ull)({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }), (Counter{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+}
+
+TEST_F(FillTest, RandomFillTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Uniform 500x333 matrix on [-2, 3) filled in parallel with seed 42:");
+	Mat U = uniform(500, 333, -2.0, 3.0, 42);
+	double sum = 0.0, low = 3.0, high = -2.0;
+	for (size_t i = 0; i < 500; i++)
+	{
+		for (size_t j = 0; j < 333; j++)
+		{
+			sum += U(i, j);
+			low = std::min(low, U(i, j));
+			high = std::max(high, U(i, j));
+		}
+	}
+
+	then("Fields lie in the interval and have the expected mean");
+	EXPECT_GE(low, -2.0);
+	EXPECT_LT(high, 3.0);
+	EXPECT_NEAR(sum / (500 * 333), 0.5, 0.02);
+
+	then("Field k is drawn from Philox block k/2 whatever the chunking");
+	const Philox4x32 generator(42);
+	for (size_t k : { size_t(0), size_t(1), size_t(12345), size_t(500 * 333 - 1) })
+	{
+		EXPECT_EQ(U(k / 333, k % 333), -2.0 + 5.0 * detail::unit<double>(generator.block(k / 2)[k % 2]));
+	}
+
+	then("Same seed reproduces the matrix, in any shape with the same number of fields");
+	EXPECT_TRUE(uniform(500, 333, -2.0, 3.0, 42) == U);
+	Mat flat = uniform(1, 500 * 333, -2.0, 3.0, 42);
+	EXPECT_EQ(flat(0, 12345), U(37, 24));
+	EXPECT_FALSE(uniform(500, 333, -2.0, 3.0, 43) == U);
+
+	given("Normal 400x400 matrix with mean 1 and deviation 2:");
+	Mat N = normal(400, 400, 1.0, 2.0, 7);
+	double mean = N.sum() / (400 * 400), variance = 0.0;
+	for (size_t i = 0; i < 400; i++)
+	{
+		for (size_t j = 0; j < 400; j++)
+		{
+			variance += (N(i, j) - mean) * (N(i, j) - mean);
+		}
+	}
+	variance /= 400 * 400 - 1;
+
+	then("Sample moments match the distribution");
+	EXPECT_NEAR(mean, 1.0, 0.03);
+	EXPECT_NEAR(std::sqrt(variance), 2.0, 0.03);
+	EXPECT_FALSE(LinearAlgebra::isnan(N));
+	EXPECT_TRUE(normal(400, 400, 1.0, 2.0, 7) == N);
+
+	then("Invalid parameters are rejected");
+	EXPECT_THROW(uniform(2, 2, 1.0, 1.0, 0), std::invalid_argument);
+	EXPECT_THROW(normal(2, 2, 0.0, -1.0, 0), std::invalid_argument);
+	EXPECT_EQ(uniform(0, 5, 0.f, 1.f, 0).getCountRows(), 0);
+}
+
+TEST_F(FillTest, DeterministicFillTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Identity, diagonal, constant and arange matrices large enough to be filled in parallel:");
+	const size_t n = 300;
+	Mat I = identity<double>(n);
+	std::vector<double> values(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		values[i] = double(i) - 7.5;
+	}
+	Mat D = diagonal(values);
+	Mat C = constant(n, n + 1, 2.5);
+	LinearAlgebra::Matrix<long long> R = arange<long long>(n, n + 3, 10, -3);
+
+	then("Every field has its expected value");
+	bool correct = true;
+	for (size_t i = 0; i < n; i++)
+	{
+		for (size_t j = 0; j < n; j++)
+		{
+			correct = correct && I(i, j) == (i == j ? 1.0 : 0.0);
+			correct = correct && D(i, j) == (i == j ? values[i] : 0.0);
+			correct = correct && C(i, j) == 2.5;
+			correct = correct && R(i, j) == 10 - 3 * (long long)(i * (n + 3) + j);
+		}
+	}
+	EXPECT_TRUE(correct);
+	EXPECT_EQ(C.getCountColumns(), n + 1);
+	EXPECT_EQ(R(n - 1, n + 2), 10 - 3 * (long long)(n * (n + 3) - 1));
+
+	then("Identity is neutral in multiplication");
+	Mat U = uniform(n, n, -1.0, 1.0, 3);
+	EXPECT_TRUE(U * I == U);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "../Matrix.hpp"
+#include "MatrixFixture.hpp"
+
+struct KernelsTest : public MatrixFixture<double>
+{
+	//textbook triple loop the blocked kernel is checked against
+	Mat naiveProduct(const Mat& A, const Mat& B)
+	{
+		Mat C(A.getCountRows(), B.getCountColumns());
+		for (size_t i = 0; i < A.getCountRows(); i++)
+		{
+			for (size_t j = 0; j < B.getCountColumns(); j++)
+			{
+				for (size_t k = 0; k < A.getCountColumns(); k++)
+				{
+					C(i, j) += A(i, k) * B(k, j);
+				}
+			}
+		}
+		return C;
+	}
+};
+
+TEST_F(KernelsTest, BlockedProductTest)
+{
+	given("Random 150x300 matrix A and 300x270 matrix B, not multiples of the block sizes:");
+	Mat A = randomMatrix(150, 300), B = randomMatrix(300, 270);
+
+	then("Blocked threaded product agrees with the triple loop");
+	EXPECT_LT(maxAbsDifference(A * B, naiveProduct(A, B)), 1e-9);
+
+	then("Matrix multiplied in place by a square matrix agrees with the product");
+	Mat C = A, S = randomMatrix(300, 300);
+	C *= S;
+	EXPECT_LT(maxAbsDifference(C, naiveProduct(A, S)), 1e-9);
+}
+
+TEST_F(KernelsTest, GemmTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Random matrices A (7x5), B (6x7) and accumulator C (5x6):");
+	Mat A = randomMatrix(7, 5), B = randomMatrix(6, 7), C = randomMatrix(5, 6);
+
+	then("gemm(2, A^T, B^T, -0.5, C) accumulates 2*A^T*B^T - 0.5*C in place");
+	Mat expected = naiveProduct(A.transposed(), B.transposed()) * 2.0 - C * 0.5;
+	const double* storage = C.data();
+	ASSERT_NO_THROW(gemm(2.0, A, Transpose::Yes, B, Transpose::Yes, -0.5, C));
+	EXPECT_EQ(C.data(), storage) << "Accumulator was reallocated!\n";
+	EXPECT_LT(maxAbsDifference(C, expected), 1e-10);
+
+	then("With beta equal to zero the accumulator is resized and never read");
+	Mat D;
+	gemm(1.0, A, Transpose::No, A, Transpose::Yes, 0.0, D);
+	EXPECT_LT(maxAbsDifference(D, naiveProduct(A, A.transposed())), 1e-10);
+
+	then("Accumulator aliasing an operand yields the same result");
+	Mat S = randomMatrix(5, 5), copy = S;
+	gemm(1.0, S, Transpose::No, S, Transpose::No, 1.0, S);
+	EXPECT_LT(maxAbsDifference(S, naiveProduct(copy, copy) + copy), 1e-10);
+
+	then("Accumulator aliasing an operand of another shape is resized only after the product is computed");
+	Mat R = arange<double>(2, 3, 1.0);
+	gemm(1.0, R, Transpose::No, R, Transpose::Yes, 0.0, R);
+	EXPECT_EQ(R, Mat(2, 2, std::vector<double>{ 14.0, 32.0, 32.0, 77.0 }));
+
+	then("Mismatched dimensions are rejected");
+	EXPECT_THROW(gemm(1.0, A, Transpose::No, B, Transpose::No, 0.0, D), std::invalid_argument);
+	EXPECT_THROW(gemm(1.0, A, Transpose::Yes, A, Transpose::No, 1.0, C), std::invalid_argument);
+}
+
+TEST_F(KernelsTest, SyrkTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Random 90x70 matrix X:");
+	Mat X = randomMatrix(90, 70);
+	Mat gram = naiveProduct(X.transposed(), X);
+
+	for (Triangle part : { Triangle::Lower, Triangle::Upper })
+	{
+		then(std::string("syrk fills only the ") + (part == Triangle::Lower ? "lower" : "upper") + " triangle of X^T*X");
+		Mat C(70, 70, [&]() { return -1.0; });
+		syrk(part, 1.0, X, Transpose::Yes, 0.0, C);
+		double error = 0.0;
+		bool untouched = true;
+		for (size_t i = 0; i < 70; i++)
+		{
+			for (size_t j = 0; j < 70; j++)
+			{
+				if ((part == Triangle::Lower) == (j <= i) || i == j)
+				{
+					error = std::max(error, std::abs(C(i, j) - gram(i, j)));
+				}
+				else
+				{
+					untouched = untouched && C(i, j) == -1.0;
+				}
+			}
+		}
+		EXPECT_LT(error, 1e-9);
+		EXPECT_TRUE(untouched) << "The other triangle was written!\n";
+	}
+
+	then("syrk without transposition accumulates X*X^T");
+	Mat G = randomMatrix(90, 90);
+	Mat expected = naiveProduct(X, X.transposed()) * 3.0 + G;
+	syrk(Triangle::Lower, 3.0, X, Transpose::No, 1.0, G);
+	EXPECT_NEAR(G(80, 3), expected(80, 3), 1e-9);
+	EXPECT_NEAR(G(45, 45), expected(45, 45), 1e-9);
+
+	then("Accumulator aliasing the operand is resized only after the product is computed");
+	Mat R = arange<double>(2, 3, 1.0);
+	syrk(Triangle::Lower, 1.0, R, Transpose::Yes, 0.0, R);
+	ASSERT_EQ(R.getCountRows(), 3);
+	EXPECT_EQ(R(0, 0), 17.0);
+	EXPECT_EQ(R(2, 1), 36.0);
+	EXPECT_EQ(R(2, 2), 45.0);
+}
+
+TEST_F(KernelsTest, ParallelForTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Pool of three workers:");
+	ThreadPool pool(3);
+
+	then("Every index is visited exactly once");
+	std::vector<int> visits(1000, 0);
+	pool.parallelFor(0, visits.size(), 7, [&](size_t first, size_t last)
+	{
+		for (size_t i = first; i < last; i++)
+		{
+			visits[i]++;
+		}
+	});
+	EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), 1000);
+
+	then("Exception thrown by a chunk is rethrown to the caller");
+	EXPECT_THROW(pool.parallelFor(0, 100, 1, [](size_t first, size_t) { if (first == 42) throw std::runtime_error("chunk failed"); }), std::runtime_error);
+}
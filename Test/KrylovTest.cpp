@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include "../Krylov.hpp"
+#include "MatrixFixture.hpp"
+
+struct KrylovTest : public MatrixFixture<double>
+{
+	typedef std::vector<double> Vec;
+	//five point Laplacian on a g x g grid with an optional convection term making it nonsymmetric
+	Mat poisson(const size_t& g, const double& convection = 0.0)
+	{
+		Mat A(g * g, g * g);
+		for (size_t i = 0; i < g; i++)
+		{
+			for (size_t j = 0; j < g; j++)
+			{
+				const size_t k = i * g + j;
+				A(k, k) = 4.0;
+				if (i > 0) A(k, k - g) = -1.0 - convection;
+				if (i + 1 < g) A(k, k + g) = -1.0 + convection;
+				if (j > 0) A(k, k - 1) = -1.0 - convection;
+				if (j + 1 < g) A(k, k + 1) = -1.0 + convection;
+			}
+		}
+		return A;
+	}
+	double relativeResidual(const Mat& A, const Vec& b, const Vec& x)
+	{
+		Vec r = b;
+		LinearAlgebra::gemv(-1.0, A, LinearAlgebra::Transpose::No, x, 1.0, r);
+		double rr = 0.0, bb = 0.0;
+		for (size_t i = 0; i < b.size(); i++)
+		{
+			rr += r[i] * r[i];
+			bb += b[i] * b[i];
+		}
+		return std::sqrt(rr / bb);
+	}
+};
+
+TEST_F(KrylovTest, GemvTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Random 300x200 matrix A and vectors x, y:");
+	Mat A = randomMatrix(300, 200);
+	Vec x = randomVector(200), z = randomVector(300), y = z;
+
+	then("gemv(2, A, x, -1, y) accumulates 2*A*x - y");
+	gemv(2.0, A, Transpose::No, x, -1.0, y);
+	double error = 0.0;
+	for (size_t i = 0; i < 300; i++)
+	{
+		double s = 0.0;
+		for (size_t j = 0; j < 200; j++)
+		{
+			s += A(i, j) * x[j];
+		}
+		error = std::max(error, std::abs(y[i] - (2.0 * s - z[i])));
+	}
+	EXPECT_LT(error, 1e-9);
+
+	then("Transposed gemv resizes the accumulator when beta is zero");
+	Vec t;
+	gemv(1.0, A, Transpose::Yes, z, 0.0, t);
+	ASSERT_EQ(t.size(), 200);
+	double s = 0.0;
+	for (size_t i = 0; i < 300; i++)
+	{
+		s += A(i, 7) * z[i];
+	}
+	EXPECT_NEAR(t[7], s, 1e-9);
+
+	then("Accumulator aliasing the vector of another size is resized only after the product is computed");
+	Vec w = x;
+	gemv(1.0, A, Transpose::No, w, 0.0, w);
+	ASSERT_EQ(w.size(), 300);
+	EXPECT_NEAR(w[11], (y[11] + z[11]) / 2.0, 1e-9);
+
+	then("Mismatched dimensions are rejected, leaving an aliased vector untouched");
+	Vec u = x;
+	EXPECT_THROW(gemv(1.0, A, Transpose::No, u, 1.0, u), std::invalid_argument);
+	EXPECT_EQ(u, x);
+	EXPECT_THROW(gemv(1.0, A, Transpose::No, z, 0.0, t), std::invalid_argument);
+	EXPECT_THROW(gemv(1.0, A, Transpose::No, x, 1.0, t), std::invalid_argument);
+}
+
+TEST_F(KrylovTest, ConjugateGradientTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Symmetric positive definite Poisson matrix on a 15x15 grid and random right-hand side:");
+	Mat A = poisson(15);
+	Vec b = randomVector(225);
+	SolverOptions<double> options;
+	options.tolerance = 1e-10;
+
+	then("Plain, Jacobi and ILU(0) preconditioned CG converge to the solution");
+	Vec x, xj, xi;
+	SolverResult<double> plain = cg(A, b, x, IdentityPreconditioner<double>(), options);
+	SolverResult<double> jacobi = cg(A, b, xj, JacobiPreconditioner<double>(A), options);
+	SolverResult<double> ilu = cg(A, b, xi, ILU0Preconditioner<double>(A), options);
+	for (const auto& [result, solution] : { std::pair(plain, x), std::pair(jacobi, xj), std::pair(ilu, xi) })
+	{
+		EXPECT_TRUE(result.converged);
+		EXPECT_LE(result.residual, 1e-10);
+		EXPECT_LT(relativeResidual(A, b, solution), 1e-9);
+	}
+
+	then("ILU(0) needs fewer iterations than no preconditioning");
+	EXPECT_LT(ilu.iterations, plain.iterations);
+
+	then("The same system stored as a sparse matrix converges to the same solution");
+	SparseMatrix<double> S(A);
+	EXPECT_EQ(S.getCountNonZeros(), 5u * 225u - 4u * 15u);
+	EXPECT_EQ(S.toMatrix(), A);
+	Vec xs;
+	SolverResult<double> sparse = cg(S, b, xs, ILU0Preconditioner<double>(S), options);
+	EXPECT_TRUE(sparse.converged);
+	EXPECT_EQ(sparse.iterations, ilu.iterations);
+	EXPECT_LT(relativeResidual(A, b, xs), 1e-9);
+
+	then("Warm start at the solution needs no iterations");
+	SolverResult<double> warm = cg(A, b, x, IdentityPreconditioner<double>(), options);
+	EXPECT_TRUE(warm.converged);
+	EXPECT_EQ(warm.iterations, 0);
+
+	then("Iteration limit stops the solver without convergence");
+	Vec y;
+	options.maxIterations = 3;
+	SolverResult<double> limited = cg(A, b, y, IdentityPreconditioner<double>(), options);
+	EXPECT_FALSE(limited.converged);
+	EXPECT_EQ(limited.iterations, 3);
+}
+
+TEST_F(KrylovTest, NonsymmetricSolversTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Nonsymmetric convection-diffusion matrix on a 14x14 grid and random right-hand side:");
+	Mat A = poisson(14, 0.4);
+	Vec b = randomVector(196);
+	SolverOptions<double> options;
+	options.tolerance = 1e-10;
+	options.restart = 20;
+
+	then("Restarted GMRES converges with and without ILU(0)");
+	Vec x, xi;
+	SolverResult<double> plain = gmres(A, b, x, IdentityPreconditioner<double>(), options);
+	SolverResult<double> ilu = gmres(A, b, xi, ILU0Preconditioner<double>(A), options);
+	EXPECT_TRUE(plain.converged);
+	EXPECT_TRUE(ilu.converged);
+	EXPECT_LT(relativeResidual(A, b, x), 1e-9);
+	EXPECT_LT(relativeResidual(A, b, xi), 1e-9);
+	EXPECT_LT(ilu.iterations, plain.iterations);
+
+	then("BiCGSTAB converges with Jacobi and ILU(0)");
+	Vec y, yi;
+	SolverResult<double> jacobi = bicgstab(A, b, y, JacobiPreconditioner<double>(A), options);
+	SolverResult<double> bilu = bicgstab(A, b, yi, ILU0Preconditioner<double>(A), options);
+	EXPECT_TRUE(jacobi.converged);
+	EXPECT_TRUE(bilu.converged);
+	EXPECT_LT(relativeResidual(A, b, y), 1e-9);
+	EXPECT_LT(relativeResidual(A, b, yi), 1e-9);
+
+	then("GMRES and BiCGSTAB on the sparse matrix converge as on the dense one");
+	SparseMatrix<double> S(A);
+	const ILU0Preconditioner<double> M(S);
+	Vec xs, ys;
+	EXPECT_TRUE(gmres(S, b, xs, M, options).converged);
+	EXPECT_TRUE(bicgstab(S, b, ys, M, options).converged);
+	EXPECT_LT(relativeResidual(A, b, xs), 1e-9);
+	EXPECT_LT(relativeResidual(A, b, ys), 1e-9);
+
+	then("Zero right-hand side gives the zero solution");
+	Vec zero(196, 0.0), z = randomVector(196);
+	EXPECT_TRUE(bicgstab(A, zero, z).converged);
+	EXPECT_EQ(z, zero);
+
+	then("Wrong sizes and non-square matrices are rejected");
+	Vec wrong(5);
+	EXPECT_THROW(gmres(A, b, wrong), std::invalid_argument);
+	EXPECT_THROW(cg(Mat(3, 4), Vec(3), x), std::invalid_argument);
+}
+
+TEST_F(KrylovTest, MatrixFreeTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Matrix-free 1D Laplacian on 4000 unknowns and its compressed sparse rows:");
+	const size_t n = 4000;
+	auto laplacian = [n](const Vec& x, Vec& y)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			y[i] = 2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i + 1 < n ? x[i + 1] : 0.0);
+		}
+	};
+	std::vector<size_t> rowStart = { 0 }, column;
+	Vec values;
+	for (size_t i = 0; i < n; i++)
+	{
+		for (size_t j = i > 0 ? i - 1 : 0; j <= std::min(i + 1, n - 1); j++)
+		{
+			column.push_back(j);
+			values.push_back(i == j ? 2.0 : -1.0);
+		}
+		rowStart.push_back(column.size());
+	}
+	Vec b = randomVector(n);
+
+	then("CG on the operator with ILU(0) from the sparse rows solves the system directly");
+	Vec x;
+	SolverOptions<double> options;
+	options.tolerance = 1e-10;
+	SolverResult<double> result = cg(laplacian, b, x, ILU0Preconditioner<double>(rowStart, column, values), options);
+	EXPECT_TRUE(result.converged);
+	EXPECT_LE(result.iterations, 2);
+	Vec r(n);
+	laplacian(x, r);
+	double error = 0.0;
+	for (size_t i = 0; i < n; i++)
+	{
+		error = std::max(error, std::abs(r[i] - b[i]));
+	}
+	EXPECT_LT(error, 1e-6);
+
+	then("Jacobi built from the diagonal works on the operator as well");
+	Vec y;
+	options.maxIterations = 5 * n;
+	EXPECT_TRUE(cg(laplacian, b, y, JacobiPreconditioner<double>(Vec(n, 2.0)), options).converged);
+
+	then("Missing diagonal and zero pivots are reported");
+	EXPECT_THROW(ILU0Preconditioner<double>(Mat(2, 2, [&]() { return 1.0; })), std::domain_error);
+	Mat offDiagonal(2, 2);
+	offDiagonal(0, 1) = offDiagonal(1, 0) = 1.0;
+	EXPECT_THROW(ILU0Preconditioner<double>{ offDiagonal }, std::domain_error);
+	EXPECT_THROW(JacobiPreconditioner<double>{ offDiagonal }, std::domain_error);
+}
+
+TEST_F(KrylovTest, SparseMatrixTest)
+{
+	using namespace LinearAlgebra;
+
+	given("1D Laplacian on 300000 unknowns in compressed sparse rows, large enough to use the thread pool:");
+	const size_t n = 300000;
+	std::vector<size_t> rowStart = { 0 }, column;
+	Vec values;
+	for (size_t i = 0; i < n; i++)
+	{
+		for (size_t j = i > 0 ? i - 1 : 0; j <= std::min(i + 1, n - 1); j++)
+		{
+			column.push_back(j);
+			values.push_back(i == j ? 2.0 : -1.0);
+		}
+		rowStart.push_back(column.size());
+	}
+	SparseMatrix<double> S(rowStart, column, values);
+	Vec x = randomVector(n);
+
+	then("Parallel SpMV matches the stencil");
+	Vec y;
+	S(x, y);
+	ASSERT_EQ(y.size(), n);
+	double error = 0.0;
+	for (size_t i = 0; i < n; i++)
+	{
+		error = std::max(error, std::abs(y[i] - (2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i + 1 < n ? x[i + 1] : 0.0))));
+	}
+	EXPECT_EQ(error, 0.0);
+
+	then("CG with the exact ILU(0) of the tridiagonal matrix recovers x from S*x");
+	Vec z;
+	SolverOptions<double> options;
+	options.tolerance = 1e-12;
+	SolverResult<double> result = cg(S, y, z, ILU0Preconditioner<double>(S), options);
+	EXPECT_TRUE(result.converged);
+	EXPECT_LE(result.iterations, 2);
+	S(z, x);
+	error = 0.0;
+	for (size_t i = 0; i < n; i++)
+	{
+		error = std::max(error, std::abs(x[i] - y[i]));
+	}
+	EXPECT_LT(error, 1e-8);
+
+	then("Malformed rows and vectors of the wrong length are rejected");
+	EXPECT_THROW(SparseMatrix<double>({ 0, 2 }, { 0, 0 }, { 1.0, 1.0 }), std::invalid_argument);
+	EXPECT_THROW(SparseMatrix<double>({ 0, 1, 0 }, { 0 }, { 1.0 }), std::invalid_argument);
+	EXPECT_THROW(SparseMatrix<double>(Mat(2, 3)), std::invalid_argument);
+	EXPECT_THROW(S(Vec(3), y), std::invalid_argument);
+}
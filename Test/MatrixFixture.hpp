@@ -0,0 +1,46 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../Fill.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//fixture shared by the test suites, seeds a fresh engine for every test and narrates the steps
+template <typename T>
+struct MatrixFixture : public ::testing::Test
+{
+	typedef LinearAlgebra::Matrix<T> Mat;
+	std::default_random_engine engine;
+	virtual void SetUp() override
+	{
+		std::random_device rd;
+		engine.seed(rd());
+	}
+	//matrix of values uniformly distributed in [-10, 10)
+	Mat randomMatrix(const size_t& m, const size_t& n)
+	{
+		return LinearAlgebra::uniform(m, n, T(-10), T(10), engine());
+	}
+	std::vector<T> randomVector(const size_t& n)
+	{
+		return randomMatrix(1, n).extractRow(0);
+	}
+	T maxAbsDifference(const Mat& A, const Mat& B)
+	{
+		return (A - B).applyOperation([](const T& v) { return std::abs(v); }).max();
+	}
+	void given(const std::string& msg, std::ostream& str = std::cout)
+	{
+		str << "Given: " << msg << "\n";
+	}
+	void then(const std::string& msg, std::ostream& str = std::cout)
+	{
+		str << "Then: " << msg << "\n";
+	}
+	void when(const std::string& msg, std::ostream& str = std::cout)
+	{
+		str << "When: " << msg << "\n";
+	}
+};
@@ -1,36 +1,14 @@
 #include <gtest/gtest.h>
 #include "../Matrix.hpp"
-#include <random>
+#include "MatrixFixture.hpp"
 #include <functional>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <utility>
 
-struct MatrixTest : public ::testing::Test
+struct MatrixTest : public MatrixFixture<long double>
 {
-	typedef LinearAlgebra::Matrix<long double> Mat;
-	std::default_random_engine engine;
-	std::uniform_real_distribution<long double> distr;
-	virtual void SetUp() override
-	{
-		std::random_device rd;
-		engine.seed(rd());
-		distr = std::uniform_real_distribution<long double>(-10.0l, 10.l);
-	}
-	virtual void TearDown() override
-	{
-
-	}
-	long double roll() { return distr(engine); }
-	Mat randomMatrix(const size_t& m, const size_t& n)
-	{
-		Mat ret(m, n);
-		for (size_t i = 0; i < m; i++)
-		{
-			for (size_t j = 0; j < n; j++)
-			{
-				ret(i, j) = roll();
-			}
-		}
-		return ret;
-	}
 	Mat identityMultiplicativeSquare(const size_t& m)
 	{
 		Mat id(m, m);
@@ -40,20 +18,6 @@ struct MatrixTest : public ::testing::Test
 		}
 		return id;
 	}
-	void given(const std::string &msg, std::ostream& str = std::cout)
-	{
-		str <<"Given: " << msg << "\n";
-	}
-	void then(const std::string& msg, std::ostream& str = std::cout)
-	{
-		str << "Then: " << msg << "\n";
-	}
-	void when(const std::string& msg, std::ostream& str = std::cout)
-	{
-		str << "When: " << msg << "\n";
-	}
-
-	
 };
 TEST_F(MatrixTest, MatrixMultiplicationTest)
 {
@@ -208,4 +172,252 @@ TEST_F(MatrixTest, MatrixClassSpecificFunctions)
 
 	then("Sum of elements of A is identically equal to zero.");
 	EXPECT_EQ(A.sum(), 0.l);
-}
\ No newline at end of file
+}
+
+TEST_F(MatrixTest, MatrixGrowthTest)
+{
+	given("Empty matrix A grown column by column to 20x50:");
+	Mat A;
+	size_t reallocations = 0;
+	for (size_t j = 0; j < 50; j++)
+	{
+		std::vector<long double> column(20);
+		for (size_t i = 0; i < 20; i++)
+		{
+			column[i] = i * 100.l + j;
+		}
+		size_t capacity = A.getCapacityColumns();
+		A.expandColumn(column);
+		reallocations += A.getCapacityColumns() != capacity;
+	}
+	ASSERT_EQ(A.getCountRows(), 20u);
+	ASSERT_EQ(A.getCountColumns(), 50u);
+
+	then("Column capacity grew geometrically and the contents are preserved");
+	EXPECT_LE(reallocations, 7u) << "Column capacity has not grown geometrically!\n";
+	EXPECT_EQ(A(13, 37), 1337.l);
+
+	when("Capacity is reserved upfront no reallocation happens while appending");
+	Mat B;
+	B.reserve(8, 6);
+	std::vector<long double> rowValues = { 1.l, 2.l, 3.l, 4.l, 5.l, 6.l, 7.l, 8.l, 9.l };
+	B.appendRows(rowValues, 3);
+	const long double* storage = &B(0, 0);
+	std::vector<long double> columnValues = { 10.l, 11.l, 12.l, 13.l, 14.l, 15.l };
+	B.appendColumns(columnValues, 2);
+	B.expandRow({ 16.l, 17.l, 18.l, 19.l, 20.l });
+	EXPECT_EQ(&B(0, 0), storage) << "Reserved storage was reallocated!\n";
+	B.print();
+	EXPECT_EQ(B.extractRow(1), (std::vector<long double>{ 4.l, 5.l, 6.l, 11.l, 14.l }));
+	EXPECT_EQ(B.extractColumn(4), (std::vector<long double>{ 13.l, 14.l, 15.l, 20.l }));
+	EXPECT_THROW(B.appendRows(rowValues, 3), std::invalid_argument);
+
+	when("Columns are appended to an empty matrix with reserved capacity");
+	Mat D;
+	D.reserve(4, 4);
+	const long double* reserved = std::as_const(D).data();
+	D.appendColumns(columnValues, 2);
+	D.expandColumn({ 16.l, 17.l, 18.l });
+	then("The matrix takes their height and the reserved storage is kept");
+	EXPECT_EQ(std::as_const(D).data(), reserved) << "Reserved storage was reallocated!\n";
+	EXPECT_EQ(D.getCountRows(), 3u);
+	EXPECT_EQ(D.extractRow(2), (std::vector<long double>{ 12.l, 15.l, 18.l }));
+
+	then("Empty matrix with columns keeps them when a column is added");
+	Mat E(0, 5);
+	E.expandColumn({});
+	EXPECT_EQ(E.getCountRows(), 0u);
+	EXPECT_EQ(E.getCountColumns(), 6u);
+	E.expandColumn({ 1.l, 2.l });
+	EXPECT_EQ(E.getCountColumns(), 7u);
+	EXPECT_EQ(E.extractRow(1), (std::vector<long double>{ 0.l, 0.l, 0.l, 0.l, 0.l, 0.l, 2.l }));
+
+	then("shrink_to_fit drops the spare columns but keeps the contents");
+	Mat C(B);
+	B.shrink_to_fit();
+	EXPECT_EQ(B.getCapacityColumns(), 5u);
+	//releasing the spare rows is only a request to the vector, its capacity is not guaranteed
+	EXPECT_GE(B.getCapacityRows(), B.getCountRows());
+	EXPECT_TRUE(B == C);
+}
+
+TEST_F(MatrixTest, MatrixBulkConstructionTest)
+{
+	given("Uninitialized 3x4 matrix A filled afterwards:");
+	Mat A(3, 4, LinearAlgebra::Uninitialized);
+	ASSERT_EQ(A.getCountRows(), 3u);
+	ASSERT_EQ(A.getCountColumns(), 4u);
+	A.modify([](long double& field) { field = 2.l; });
+	A.print();
+	EXPECT_EQ(A.sum(), 24.l);
+
+	given("Buffer of 6 values stored row after row:");
+	std::vector<long double> values = { 1.l, 2.l, 3.l, 4.l, 5.l, 6.l };
+
+	then("Matrix copied from the buffer has the values in row-major order");
+	Mat B(2, 3, values);
+	B.print();
+	EXPECT_EQ(B(1, 0), 4.l);
+	EXPECT_EQ(B.extractColumn(2), (std::vector<long double>{ 3.l, 6.l }));
+	EXPECT_THROW(Mat(4, 2, values), std::invalid_argument) << "Buffer of wrong size was accepted!\n";
+
+	then("Matrix adopting a storage buffer uses it without copying");
+	Mat::Storage storage(values.begin(), values.end());
+	const long double* data = storage.data();
+	Mat C(3, 2, std::move(storage));
+	EXPECT_EQ(&C(0, 0), data) << "Adopted buffer was copied!\n";
+	EXPECT_EQ(C(2, 1), 6.l);
+	EXPECT_TRUE(C.transposed() == Mat(2, 3, std::vector<long double>{ 1.l, 3.l, 5.l, 2.l, 4.l, 6.l }));
+
+	then("Results of the operators are fully written");
+	EXPECT_TRUE(B * C == Mat(2, 2, std::vector<long double>{ 22.l, 28.l, 49.l, 64.l }));
+	EXPECT_TRUE(B + B == B * 2.l);
+	EXPECT_TRUE(B.hadamardProduct(B) == B.applyOperation(B, [](const long double& a, const long double& b) { return a * b; }));
+}
+
+TEST_F(MatrixTest, IntegerMatrixTest)
+{
+	typedef LinearAlgebra::Matrix<int> IntMat;
+
+	given("Integer matrix with only negative entries:");
+	IntMat N(2, 2, []() { return -3; });
+	N(1, 0) = -1;
+	std::ostringstream printed;
+	N.print(printed);
+	std::cout << printed.str();
+
+	then("Fields are printed as integers and the maximum is the largest negative entry");
+	EXPECT_EQ(printed.str(), "|-3|-3|\n|-1|-3|\n\n");
+	EXPECT_EQ(N.max(), -1);
+	EXPECT_EQ(N.sum(), -10);
+
+	given("5x5 integer matrix with known determinant:");
+	IntMat A(5, 5, LinearAlgebra::Uninitialized);
+	std::vector<std::vector<int>> rows = { { 2, -1, 0, 3, 1 }, { 4, 0, -2, 1, 5 }, { -3, 2, 1, 0, -1 }, { 1, 1, 1, 1, 1 }, { 0, 3, -4, 2, 2 } };
+	for (size_t i = 0; i < 5; i++)
+	{
+		A.changeRow(rows[i], i);
+	}
+	A.print();
+
+	then("Fraction-free elimination yields the exact determinant, equal to the cofactor expansion");
+	long long expansion = 0;
+	for (size_t j = 0; j < 5; j++)
+	{
+		expansion += (long long)A(0, j) * A.cofactor(0, j);
+	}
+	EXPECT_EQ(A.det(), expansion);
+	EXPECT_EQ(A.det(), 208);
+	EXPECT_EQ(A.transposed().det(), A.det());
+
+	then("Singular integer matrix has zero determinant");
+	A.changeRow(rows[3], 4);
+	EXPECT_EQ(A.det(), 0);
+
+	given("64-bit integers which cannot be represented exactly as double:");
+	LinearAlgebra::Matrix<long long> L(1, 1, []() { return (1ll << 53) + 1; });
+	LinearAlgebra::Matrix<long long> one(1, 1, []() { return 1ll; });
+
+	then("Integer products are exact");
+	EXPECT_EQ((L * one)(0, 0), (1ll << 53) + 1);
+	EXPECT_EQ(L.dot(one), (1ll << 53) + 1);
+
+	then("Overflowing integer arithmetic throws instead of wrapping");
+	IntMat big(2, 2, []() { return std::numeric_limits<int>::max(); });
+	EXPECT_THROW(big.sum(), std::overflow_error);
+	EXPECT_THROW(big * big, std::overflow_error);
+	EXPECT_THROW(big.dot(big), std::overflow_error);
+	EXPECT_FALSE(LinearAlgebra::isnan(big));
+
+	given("Unsigned matrix whose elimination passes through a negative minor:");
+	std::vector<unsigned> fields = { 1, 2, 1, 2, 1, 1, 0, 1, 0 };
+	LinearAlgebra::Matrix<unsigned> U(3, 3, std::span<const unsigned>(fields));
+
+	then("Determinant is exact, only a negative result does not fit the element type");
+	EXPECT_EQ(U.det(), 1u);
+	LinearAlgebra::Matrix<unsigned long long> swap(2, 2);
+	swap(0, 1) = swap(1, 0) = std::numeric_limits<unsigned long long>::max();
+	EXPECT_THROW(swap.det(), std::overflow_error);
+	swap(0, 0) = swap(1, 1) = 1;
+	swap(0, 1) = swap(1, 0) = 0;
+	EXPECT_EQ(swap.det(), 1ull);
+}
+
+TEST_F(MatrixTest, CopyOnWriteTest)
+{
+	given("Random 40x30 matrix A and its copy B:");
+	Mat A = randomMatrix(40, 30);
+	Mat B = A, C;
+	C = A;
+
+	then("Copies share the fields of A until written");
+	EXPECT_EQ(std::as_const(B).data(), std::as_const(A).data());
+	EXPECT_EQ(std::as_const(C).data(), std::as_const(A).data());
+
+	then("Writing a copy detaches it and leaves the others untouched");
+	const long double original = std::as_const(A)(3, 4);
+	B(3, 4) = original + 1.l;
+	EXPECT_NE(std::as_const(B).data(), std::as_const(A).data());
+	EXPECT_EQ(std::as_const(A)(3, 4), original);
+	EXPECT_EQ(std::as_const(C)(3, 4), original);
+	EXPECT_EQ(std::as_const(B)(3, 4), original + 1.l);
+
+	then("Writing the original detaches it from the remaining copy");
+	A.expandRow(std::vector<long double>(30, 1.l));
+	EXPECT_EQ(A.getCountRows(), 41);
+	EXPECT_EQ(C.getCountRows(), 40);
+	EXPECT_EQ(std::as_const(C)(3, 4), original);
+
+	then("Sole owner writes in place without copying");
+	const long double* storage = std::as_const(C).data();
+	C(0, 0) = 0.l;
+	C *= 2.l;
+	EXPECT_EQ(std::as_const(C).data(), storage);
+
+	then("References taken before copying keep writing into the original only");
+	long double& field = C(0, 0);
+	std::span<long double> row = C[1];
+	const Mat D = C;
+	field = 42.l;
+	row[0] = 43.l;
+	EXPECT_EQ(D(0, 0), 0.l);
+	EXPECT_EQ(D(1, 0), 2.l * std::as_const(A)(1, 0));
+	EXPECT_EQ(std::as_const(C)(0, 0), 42.l);
+	EXPECT_EQ(std::as_const(C)(1, 0), 43.l);
+
+	then("Copies of the separated copy share its fields again");
+	const Mat E = D;
+	EXPECT_EQ(E.data(), D.data());
+}
+
+TEST_F(MatrixTest, ConcurrentReadTest)
+{
+	given("Random 64x64 matrix W shared by eight threads:");
+	const Mat W = randomMatrix(64, 64);
+	const Mat expectedProduct = W * W;
+	const long double expectedSum = W.sum();
+
+	then("Concurrent const operations and private copies see the same fields");
+	std::vector<std::thread> threads;
+	std::vector<int> failures(8, 0);
+	for (size_t t = 0; t < 8; t++)
+	{
+		threads.emplace_back([&, t]()
+		{
+			for (int round = 0; round < 10; round++)
+			{
+				Mat copy = W;
+				failures[t] += !(W * W == expectedProduct);
+				failures[t] += W.sum() != expectedSum;
+				failures[t] += !(W.transposed().transposed() == W);
+				copy(0, 0) += 1.l;
+				failures[t] += copy(0, 0) != W(0, 0) + 1.l;
+			}
+		});
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_EQ(std::count(failures.begin(), failures.end(), 0), 8);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "../Structured.hpp"
+#include "MatrixFixture.hpp"
+#include <utility>
+
+struct StructuredTest : public MatrixFixture<double>
+{
+	//random matrix with a dominant diagonal, so that it is well conditioned
+	Mat randomDominant(const size_t& n)
+	{
+		Mat A = randomMatrix(n, n);
+		for (size_t i = 0; i < n; i++)
+		{
+			A(i, i) += 20.0 * n;
+		}
+		return A;
+	}
+};
+
+TEST_F(StructuredTest, SymmetricMatrixTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Symmetric 6x6 matrix S built from the lower triangle of a random matrix:");
+	Mat A = randomDominant(6);
+	SymmetricMatrix<double> S(A);
+	Mat dense = S.toMatrix();
+	dense.print();
+
+	then("Conversion to Matrix is symmetric and keeps the lower triangle");
+	EXPECT_TRUE(dense == dense.transposed());
+	EXPECT_EQ(dense(4, 1), A(4, 1));
+	EXPECT_EQ(dense(1, 4), A(4, 1));
+
+	then("Multiplication, solve and determinant agree with the dense matrix");
+	Mat B = randomMatrix(6, 2);
+	EXPECT_LT(maxAbsDifference(S * B, dense * B), 1e-10);
+	EXPECT_LT(maxAbsDifference(dense * S.solve(B), B), 1e-10);
+	EXPECT_NEAR(S.det(), dense.det(), 1e-9 * std::abs(dense.det()));
+
+	given("Symmetric matrix with zero leading pivot:");
+	SymmetricMatrix<double> Z(2);
+	Z(0, 1) = 2.0;
+	Z(1, 1) = 1.0;
+
+	then("Solve and determinant fall back to pivoting");
+	EXPECT_EQ(Z.det(), -4.0);
+	Mat rhs(2, 1);
+	rhs(0, 0) = 2.0;
+	rhs(1, 0) = 3.0;
+	EXPECT_LT(maxAbsDifference(Z.toMatrix() * Z.solve(rhs), rhs), 1e-12);
+
+	given("Indefinite 40x40 symmetric matrix with tiny diagonal:");
+	Mat R = randomMatrix(40, 40);
+	for (size_t i = 0; i < 40; i++)
+	{
+		R(i, i) = 1e-13 * R(i, i);
+	}
+	SymmetricMatrix<double> I(R);
+	Mat denseI = I.toMatrix();
+
+	then("Symmetric pivoting keeps solve and determinant accurate");
+	Mat rhsI = randomMatrix(40, 3);
+	EXPECT_LT(maxAbsDifference(denseI * I.solve(rhsI), rhsI), 1e-8);
+	const double reference = BandMatrix<double>(denseI, 39, 39).det();
+	EXPECT_NEAR(I.det(), reference, 1e-8 * std::abs(reference));
+
+	then("Singular matrix has zero determinant and no solution");
+	SymmetricMatrix<double> S0(3);
+	S0(0, 0) = 1.0;
+	S0(1, 0) = 2.0;
+	S0(1, 1) = 4.0;
+	EXPECT_EQ(S0.det(), 0.0);
+	EXPECT_THROW(S0.solve(Mat(3, 1)), std::domain_error);
+}
+
+TEST_F(StructuredTest, TriangularMatrixTest)
+{
+	using namespace LinearAlgebra;
+
+	for (Triangle part : { Triangle::Lower, Triangle::Upper })
+	{
+		given(std::string(part == Triangle::Lower ? "Lower" : "Upper") + " triangular 5x5 matrix L:");
+		TriangularMatrix<double> L(randomDominant(5), part);
+		Mat dense = L.toMatrix();
+		dense.print();
+
+		then("Fields outside of the triangle are zero and cannot be accessed for writing");
+		EXPECT_EQ(part == Triangle::Lower ? std::as_const(L)(1, 3) : std::as_const(L)(3, 1), 0.0);
+		EXPECT_THROW(part == Triangle::Lower ? L.at(1, 3) : L.at(3, 1), std::out_of_range);
+
+		then("Multiplication, substitution and determinant agree with the dense matrix");
+		Mat B = randomMatrix(5, 3);
+		EXPECT_LT(maxAbsDifference(L * B, dense * B), 1e-10);
+		EXPECT_LT(maxAbsDifference(dense * L.solve(B), B), 1e-9);
+		EXPECT_NEAR(L.det(), dense.det(), 1e-9 * std::abs(dense.det()));
+	}
+}
+
+TEST_F(StructuredTest, BandMatrixTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Tridiagonal 7x7 matrix of the second difference operator:");
+	BandMatrix<double> D(7, 1, 1);
+	for (size_t i = 0; i < 7; i++)
+	{
+		D(i, i) = 2.0;
+		if (i > 0) D(i, i - 1) = -1.0;
+		if (i < 6) D(i, i + 1) = -1.0;
+	}
+	D.toMatrix().print();
+
+	then("Determinant is n+1 and the Thomas solve inverts the multiplication");
+	EXPECT_NEAR(D.det(), 8.0, 1e-12);
+	Mat B = randomMatrix(7, 2);
+	EXPECT_LT(maxAbsDifference(D * D.solve(B), B), 1e-10);
+
+	given("Tridiagonal 2x2 matrix which is not diagonally dominant:");
+	BandMatrix<double> N(2, 1, 1);
+	N(0, 0) = 1e-20;
+	N(0, 1) = 1.0;
+	N(1, 0) = 1.0;
+	N(1, 1) = 1.0;
+
+	then("Solve pivots instead of dividing by the tiny diagonal");
+	Mat x = N.solve(Mat(2, 1, std::vector<double>{ 1.0, 2.0 }));
+	EXPECT_NEAR(x(0, 0), 1.0, 1e-12);
+	EXPECT_NEAR(x(1, 0), 1.0, 1e-12);
+
+	given("Band matrix with two sub- and one superdiagonal cut out of a random matrix:");
+	BandMatrix<double> W(randomMatrix(8, 8), 2, 1);
+	Mat dense = W.toMatrix();
+	dense.print();
+
+	then("Fields outside the band are zero, multiplication, banded LU and determinant agree with the dense matrix");
+	EXPECT_EQ(std::as_const(W)(0, 5), 0.0);
+	EXPECT_EQ(dense(6, 2), 0.0);
+	Mat C = randomMatrix(8, 3);
+	EXPECT_LT(maxAbsDifference(W * C, dense * C), 1e-10);
+	EXPECT_LT(maxAbsDifference(dense * W.solve(C), C), 1e-8);
+	EXPECT_NEAR(W.det(), dense.det(), 1e-8 * std::abs(dense.det()));
+
+	then("Singular band matrix has no solution");
+	EXPECT_THROW(BandMatrix<double>(4, 1, 1).solve(Mat(4, 1)), std::domain_error);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../TaskGraph.hpp"
+#include "MatrixFixture.hpp"
+#include <chrono>
+#include <future>
+
+struct TaskGraphTest : public MatrixFixture<long double>
+{
+};
+
+TEST_F(TaskGraphTest, ChainedOperationsTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Random 4x4 matrices A, B, C, D:");
+	Mat A = randomMatrix(4, 4), B = randomMatrix(4, 4), C = randomMatrix(4, 4), D = randomMatrix(4, 4);
+
+	then("Graph (A*B + C*D)^T - B computes the same result as blocking calls");
+	Task<Mat> a = ready(A), b = ready(B), c = ready(C), d = ready(D);
+	Task<Mat> result = transposed(a * b + c * d) - b;
+	Mat expected = (A * B + C * D).transposed() - B;
+	ASSERT_NO_THROW(result.get());
+	EXPECT_TRUE(result.get() == expected) << "Task graph yields different result than blocking calls!\n";
+	EXPECT_TRUE(result.ready());
+
+	then("Custom nodes receive the values of their dependencies");
+	Task<long double> trace = schedule([](const Mat& m) { return m(0, 0) + m(1, 1) + m(2, 2) + m(3, 3); }, result);
+	EXPECT_EQ(trace.get(), expected(0, 0) + expected(1, 1) + expected(2, 2) + expected(3, 3));
+}
+
+TEST_F(TaskGraphTest, ExceptionPropagationTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Graph multiplying matrices of mismatched dimensions:");
+	Task<Mat> product = ready(randomMatrix(2, 3)) * ready(randomMatrix(2, 3));
+	Task<Mat> dependent = product + ready(randomMatrix(2, 3));
+
+	then("The failure is rethrown by the node and by everything depending on it");
+	EXPECT_THROW(product.get(), std::invalid_argument);
+	EXPECT_THROW(dependent.get(), std::invalid_argument);
+}
+
+TEST_F(TaskGraphTest, IndependentNodesRunConcurrentlyTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Pool of two workers and two independent nodes waiting for each other:");
+	ThreadPool pool(2);
+	std::promise<void> firstStarted, secondStarted;
+	std::shared_future<void> first = firstStarted.get_future().share(), second = secondStarted.get_future().share();
+	Task<int> start = ready(0);
+	Task<bool> x = schedule(pool, [&](int) { firstStarted.set_value(); return second.wait_for(std::chrono::seconds(10)) == std::future_status::ready; }, start);
+	Task<bool> y = schedule(pool, [&](int) { secondStarted.set_value(); return first.wait_for(std::chrono::seconds(10)) == std::future_status::ready; }, start);
+
+	then("Both nodes observe each other running");
+	EXPECT_TRUE(x.get() && y.get()) << "Independent nodes were serialized!\n";
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "../Tiled.hpp"
+#include "MatrixFixture.hpp"
+#include <numeric>
+#include <utility>
+
+struct TiledTest : public MatrixFixture<double>
+{
+	typedef LinearAlgebra::Matrix<double, LinearAlgebra::Tiled<8, LinearAlgebra::TileOrder::Morton>> Morton;
+	typedef LinearAlgebra::Matrix<double, LinearAlgebra::Tiled<4, LinearAlgebra::TileOrder::RowMajor>> Blocked;
+	//runs the operations on the tiled layout and checks them against the row-major matrix
+	template <typename TiledMat>
+	void checkOperations()
+	{
+		Mat A = randomMatrix(37, 53), B = randomMatrix(37, 53), C = randomMatrix(53, 29);
+		TiledMat TA(A), TB(B), TC(C);
+
+		EXPECT_EQ(TA.toRowMajor(), A);
+		EXPECT_EQ(TA(36, 52), A(36, 52));
+		EXPECT_EQ(TA(17, 9), A(17, 9));
+		EXPECT_THROW(TA.at(37, 0), std::out_of_range);
+
+		EXPECT_EQ((TA + TB).toRowMajor(), A + B);
+		EXPECT_EQ((TA - TB).toRowMajor(), A - B);
+		EXPECT_EQ((TA * 2.5).toRowMajor(), A * 2.5);
+		EXPECT_EQ((TA / 4.0).toRowMajor(), A / 4.0);
+		EXPECT_EQ(TA.transposed().toRowMajor(), A.transposed());
+		EXPECT_EQ(TA.hadamardProduct(TB).toRowMajor(), A.hadamardProduct(B));
+		EXPECT_LT(maxAbsDifference((TA * TC).toRowMajor(), A * C), 1e-10);
+		EXPECT_NEAR(TA.dot(TB), A.dot(B), 1e-9);
+		EXPECT_NEAR(TA.sum(), A.sum(), 1e-9);
+		EXPECT_EQ(TA.max(), A.max());
+		EXPECT_EQ(TA.extractRow(30), A.extractRow(30));
+		EXPECT_EQ(TA.extractColumn(50), A.extractColumn(50));
+		EXPECT_THROW(TA * TB, std::invalid_argument);
+		EXPECT_THROW(TA + TC, std::invalid_argument);
+		EXPECT_THROW(TA / 0.0, std::invalid_argument);
+
+		auto square = [](const double& v) { return v * v; };
+		EXPECT_EQ(TA.applyOperation(square).toRowMajor(), A.applyOperation(square));
+		EXPECT_EQ(TA.applyOperation(TB, [](const double& a, const double& b) { return a - 2 * b; }).toRowMajor(), A.applyOperation(B, [](const double& a, const double& b) { return a - 2 * b; }));
+
+		TiledMat D = TA;
+		Mat E = A;
+		D += TB;
+		D *= 3.0;
+		D -= TA;
+		D /= 2.0;
+		E += B;
+		E *= 3.0;
+		E -= A;
+		E /= 2.0;
+		EXPECT_EQ(D.toRowMajor(), E);
+		D.modify([](double& v) { v = -v; });
+		E.modify([](double& v) { v = -v; });
+		D.changeRow(std::vector<double>(53, 1.0), 3);
+		E.changeRow(std::vector<double>(53, 1.0), 3);
+		D.changeColumn(std::vector<double>(37, 2.0), 40);
+		E.changeColumn(std::vector<double>(37, 2.0), 40);
+		EXPECT_EQ(D.toRowMajor(), E);
+		EXPECT_TRUE(D == TiledMat(E));
+		EXPECT_FALSE(D == TA);
+
+		Mat S = randomMatrix(5, 5);
+		TiledMat TS(S);
+		EXPECT_NEAR(TS.det(), S.det(), 1e-9 * std::abs(S.det()) + 1e-9);
+		EXPECT_LT(maxAbsDifference((TS * TS.inverse()).toRowMajor(), LinearAlgebra::identity<double>(5)), 1e-9);
+	}
+	//grows the tiled layout and the row-major matrix the same way and compares them
+	template <typename TiledMat>
+	void checkGrowth()
+	{
+		Mat A;
+		TiledMat T;
+		for (size_t i = 0; i < 11; i++)
+		{
+			std::vector<double> row = randomMatrix(1, 6).extractRow(0);
+			A.expandRow(row);
+			T.expandRow(row);
+		}
+		for (size_t j = 0; j < 13; j++)
+		{
+			std::vector<double> column = randomMatrix(1, 11).extractRow(0);
+			A.expandColumn(column);
+			T.expandColumn(column);
+		}
+		std::vector<double> rows = randomMatrix(3, 19).extractRow(0);
+		rows.resize(3 * 19);
+		A.appendRows(rows, 3);
+		T.appendRows(rows, 3);
+		std::vector<double> columns(14 * 2, 1.5);
+		A.appendColumns(columns, 2);
+		T.appendColumns(columns, 2);
+		EXPECT_EQ(T.getCountRows(), 14);
+		EXPECT_EQ(T.getCountColumns(), 21);
+		EXPECT_EQ(T.toRowMajor(), A);
+		EXPECT_NEAR(T.sum(), A.sum(), 1e-9);
+
+		T.reserve(100, 100);
+		EXPECT_GE(T.getCapacityRows(), 100);
+		EXPECT_GE(T.getCapacityColumns(), 100);
+		EXPECT_EQ(T.toRowMajor(), A);
+		T.shrink_to_fit();
+		EXPECT_LT(T.getCapacityRows(), 14 + T.getTileSize());
+		EXPECT_EQ(T.toRowMajor(), A);
+		EXPECT_EQ(T.transposed().toRowMajor(), A.transposed());
+
+		//a matrix without rows keeps its columns and its reserved grid when columns are appended
+		Mat N(0, 3);
+		TiledMat TN(0, 3);
+		TN.reserve(4, 24);
+		const double* reserved = std::as_const(TN).data();
+		N.expandColumn({ 1.0, 2.0 });
+		TN.expandColumn({ 1.0, 2.0 });
+		N.appendColumns(columns, 14);
+		TN.appendColumns(columns, 14);
+		EXPECT_EQ(std::as_const(TN).data(), reserved);
+		EXPECT_EQ(TN.getCountColumns(), 18);
+		EXPECT_EQ(TN.toRowMajor(), N);
+	}
+};
+
+TEST_F(TiledTest, TileOrderTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Grids of 4x4 and 3x5 tiles:");
+	std::vector<size_t> z = detail::tileSlots(4, 4, TileOrder::Morton);
+
+	then("Morton order visits the tiles along the Z curve");
+	EXPECT_EQ(z[0 * 4 + 0], 0);
+	EXPECT_EQ(z[0 * 4 + 1], 1);
+	EXPECT_EQ(z[1 * 4 + 0], 2);
+	EXPECT_EQ(z[1 * 4 + 1], 3);
+	EXPECT_EQ(z[0 * 4 + 2], 4);
+	EXPECT_EQ(z[2 * 4 + 0], 8);
+	EXPECT_EQ(z[3 * 4 + 3], 15);
+
+	then("Slots stay dense for grids which are not powers of two, row-major order keeps the grid order");
+	std::vector<size_t> slots = detail::tileSlots(3, 5, TileOrder::Morton);
+	std::sort(slots.begin(), slots.end());
+	std::vector<size_t> expected(15);
+	std::iota(expected.begin(), expected.end(), size_t(0));
+	EXPECT_EQ(slots, expected);
+	EXPECT_EQ(detail::tileSlots(3, 5, TileOrder::RowMajor), expected);
+
+	then("Neighbouring fields of one column lie in one tile");
+	Morton M(16, 16, [n = 0.0]() mutable { return n++; });
+	EXPECT_EQ(&std::as_const(M)(5, 3) - &std::as_const(M)(4, 3), 8);
+	EXPECT_EQ(M.toRowMajor(), arange<double>(16, 16));
+}
+
+TEST_F(TiledTest, MortonOperationsTest)
+{
+	given("Random 37x53 matrices converted to 8x8 tiles in Morton order:");
+	then("Every operation agrees with the row-major layout");
+	checkOperations<Morton>();
+	checkGrowth<Morton>();
+}
+
+TEST_F(TiledTest, BlockedOperationsTest)
+{
+	given("Random 37x53 matrices converted to 4x4 tiles in row-major order:");
+	then("Every operation agrees with the row-major layout");
+	checkOperations<Blocked>();
+	checkGrowth<Blocked>();
+}
+
+TEST_F(TiledTest, TiledSpecificTest)
+{
+	using namespace LinearAlgebra;
+
+	given("Large product filling several 32x32 tiles:");
+	Mat A = randomMatrix(150, 130), B = randomMatrix(130, 170);
+	Matrix<double, Tiled<>> TA(A), TB(B);
+
+	then("Tiled product agrees with the row-major one");
+	EXPECT_LT(maxAbsDifference((TA * TB).toRowMajor(), A * B), 1e-9);
+
+	then("Copies share the tiles until written");
+	Matrix<double, Tiled<>> copy = TA;
+	EXPECT_EQ(std::as_const(copy).data(), std::as_const(TA).data());
+	copy(0, 0) += 1.0;
+	EXPECT_NE(std::as_const(copy).data(), std::as_const(TA).data());
+	EXPECT_EQ(std::as_const(TA)(0, 0), A(0, 0));
+	double& field = copy(1, 1);
+	const Matrix<double, Tiled<>> snapshot = copy;
+	field = 42.0;
+	EXPECT_EQ(snapshot(1, 1), A(1, 1));
+
+	then("Construction from row-major values and from a generator fills the fields in row-major order");
+	std::vector<double> values(6 * 7);
+	std::iota(values.begin(), values.end(), 0.0);
+	Matrix<double, Tiled<4>> V(6, 7, std::span<const double>(values));
+	EXPECT_EQ(V.toRowMajor(), arange<double>(6, 7));
+	EXPECT_THROW((Matrix<double, Tiled<4>>(2, 2, std::span<const double>(values))), std::invalid_argument);
+
+	given("Integer matrices in tiles:");
+	Matrix<long long, Tiled<4>> L(5, 5, [n = 0ll]() mutable { return n++ % 7; });
+	Matrix<long long> R = L.toRowMajor();
+
+	then("Products stay exact and determinant matches the row-major one");
+	EXPECT_EQ((L * L).toRowMajor(), R * R);
+	EXPECT_EQ(L.det(), R.det());
+	Matrix<int, Tiled<4>> big(2, 2, []() { return std::numeric_limits<int>::max(); });
+	EXPECT_THROW(big * big, std::overflow_error);
+	EXPECT_THROW(big.sum(), std::overflow_error);
+
+	then("Padding never leaks into the results");
+	Matrix<double, Tiled<8>> N(3, 3, []() { return -1.0; });
+	EXPECT_EQ(N.max(), -1.0);
+	EXPECT_EQ(N.sum(), -9.0);
+	Matrix<double, Tiled<8>> infinite(3, 3, []() { return std::numeric_limits<double>::infinity(); });
+	EXPECT_EQ((infinite * N).sum(), -std::numeric_limits<double>::infinity());
+}
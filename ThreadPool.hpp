@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	//fixed set of worker threads executing queued jobs in submission order
+	class ThreadPool
+	{
+		std::vector<std::thread> workers;
+		std::deque<std::function<void()>> jobs;
+		std::mutex mutex;
+		std::condition_variable available;
+		bool stopping;
+
+		void work();
+
+	public:
+		//constructor starting given number of workers (at least one)
+		explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+		//finishes all queued jobs and joins the workers
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		//queue job for execution, jobs must not block waiting for other queued jobs
+		void enqueue(std::function<void()> job);
+
+		//calls body(first, last) on consecutive chunks of [begin, end) of at most grain indices, returns after all of them finished;
+		//the calling thread processes chunks too, so it is safe to call from inside a job
+		template <typename F>
+		void parallelFor(size_t begin, size_t end, size_t grain, F body) noexcept(false);
+
+		size_t size() const noexcept { return workers.size(); }
+
+		//pool shared by the whole library, sized to the hardware concurrency
+		static ThreadPool& shared();
+	};
+
+	inline ThreadPool::ThreadPool(size_t threads) :workers(), jobs(), mutex(), available(), stopping(false)
+	{
+		threads = threads ? threads : 1;
+		workers.reserve(threads);
+		for (size_t i = 0; i < threads; i++)
+		{
+			workers.emplace_back(&ThreadPool::work, this);
+		}
+	}
+
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		available.notify_all();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	inline void ThreadPool::work()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				available.wait(lock, [this]() { return stopping || !jobs.empty(); });
+				if (jobs.empty())
+				{
+					return;
+				}
+				job = std::move(jobs.front());
+				jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	inline void ThreadPool::enqueue(std::function<void()> job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			jobs.push_back(std::move(job));
+		}
+		available.notify_one();
+	}
+
+	template <typename F>
+	void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, F body) noexcept(false)
+	{
+		grain = grain ? grain : 1;
+		const size_t chunks = end > begin ? (end - begin + grain - 1) / grain : 0;
+		if (chunks <= 1 || workers.size() == 1)
+		{
+			if (chunks)
+			{
+				body(begin, end);
+			}
+			return;
+		}
+		struct State
+		{
+			std::atomic<size_t> next{ 0 };
+			size_t done = 0;
+			std::mutex mutex;
+			std::condition_variable finished;
+			std::exception_ptr error;
+		};
+		auto state = std::make_shared<State>();
+		F* shared = &body;
+		//body is reached only after claiming a chunk, which keeps the caller waiting, so it is still alive
+		auto work = [state, shared, begin, end, grain, chunks]()
+		{
+			for (size_t chunk; (chunk = state->next.fetch_add(1)) < chunks;)
+			{
+				std::exception_ptr error;
+				try
+				{
+					(*shared)(begin + chunk * grain, std::min(end, begin + (chunk + 1) * grain));
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+				std::lock_guard<std::mutex> lock(state->mutex);
+				if (error && !state->error)
+				{
+					state->error = error;
+				}
+				if (++state->done == chunks)
+				{
+					state->finished.notify_all();
+				}
+			}
+		};
+		const size_t helpers = std::min(workers.size(), chunks) - 1;
+		for (size_t i = 0; i < helpers; i++)
+		{
+			enqueue(work);
+		}
+		work();
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->finished.wait(lock, [&]() { return state->done == chunks; });
+		if (state->error)
+		{
+			std::rethrow_exception(state->error);
+		}
+	}
+
+	inline ThreadPool& ThreadPool::shared()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+}
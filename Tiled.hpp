@@ -0,0 +1,1059 @@
+#pragma once
+#include "Matrix.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace LinearAlgebra
+{
+	namespace detail
+	{
+		//number of fields one chunk of a parallel tile loop processes
+		constexpr size_t TileGrain = 1 << 14;
+
+		//spreads the bits of x apart, leaving a zero bit between every two of them
+		inline std::uint64_t spreadBits(std::uint64_t x) noexcept
+		{
+			x &= 0xFFFFFFFFull;
+			x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+			x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+			x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+			x = (x | (x << 2)) & 0x3333333333333333ull;
+			x = (x | (x << 1)) & 0x5555555555555555ull;
+			return x;
+		}
+
+		//slot in the storage of every tile of a grid, tile (I, J) being at index I*tileColumns+J;
+		//Morton order sorts the tiles by their interleaved coordinates and keeps the slots dense for any grid shape
+		inline std::vector<size_t> tileSlots(size_t tileRows, size_t tileColumns, TileOrder order)
+		{
+			std::vector<size_t> slots(tileRows * tileColumns);
+			std::iota(slots.begin(), slots.end(), size_t(0));
+			if (order == TileOrder::Morton && tileColumns)
+			{
+				std::vector<size_t> sequence(slots);
+				auto code = [tileColumns](size_t t) { return (spreadBits(t / tileColumns) << 1) | spreadBits(t % tileColumns); };
+				std::sort(sequence.begin(), sequence.end(), [&](size_t a, size_t b) { return code(a) < code(b); });
+				for (size_t rank = 0; rank < sequence.size(); rank++)
+				{
+					slots[sequence[rank]] = rank;
+				}
+			}
+			return slots;
+		}
+	}
+
+	//matrix stored in Size x Size tiles, giving locality along rows and columns alike;
+	//it offers the operations of the row-major Matrix except the row spans of operator[] and adopting a row-major buffer,
+	//the free algorithms (gemm, decompositions, solvers) take the row-major matrix returned by toRowMajor()
+	template <typename T, size_t Size, TileOrder Order>
+	class Matrix<T, Tiled<Size, Order>>
+	{
+		//checked here, naming Tiled<Size, Order> as the layout argument does not instantiate it
+		static_assert(Size > 0 && (Size & (Size - 1)) == 0, "Tile size has to be a power of two!");
+
+	public:
+		typedef std::vector<T, DefaultInitAllocator<T>> Storage;
+
+		//number of fields in one tile
+		static constexpr size_t TileFields = Size * Size;
+
+	private:
+		//tiles stored one after another, fields of the tiles lying outside the matrix are kept zero;
+		//copies share it until one of them is written, or copy it right away once non-const access exposed it
+		detail::SharedBuffer<Storage> context;
+		//slot of every tile of the grid, never modified so copies share it
+		std::shared_ptr<const std::vector<size_t>> slots;
+		size_t rows, columns;
+		//dimensions of the allocated grid of tiles
+		size_t tileRows, tileColumns;
+
+		static size_t tilesFor(const size_t& count) noexcept { return (count + Size - 1) / Size; }
+
+		static std::shared_ptr<const std::vector<size_t>> layout(size_t TileRows, size_t TileColumns) { return std::make_shared<const std::vector<size_t>>(detail::tileSlots(TileRows, TileColumns, Order)); }
+
+		//offset of the first field of tile (I, J) in the storage
+		size_t offset(const size_t& I, const size_t& J) const noexcept { return (*slots)[I * tileColumns + J] * TileFields; }
+
+		size_t index(const size_t& Row, const size_t& Col) const noexcept { return offset(Row / Size, Col / Size) + (Row % Size) * Size + Col % Size; }
+
+		//moves the fields into a grid of the given number of tiles
+		void regrid(const size_t& newTileRows, const size_t& newTileColumns);
+
+		//makes room for given dimensions, growing the grid geometrically
+		void grow(const size_t& newRows, const size_t& newColumns);
+
+		//zeroes the fields of the grid lying outside the matrix
+		void clearPadding();
+
+		//calls f(I, J, height, width) for every tile intersecting the matrix, height x width being its part inside
+		template <typename F>
+		void forTiles(F f, bool parallel) const;
+
+		//result(i, j) = f(this(i, j), W(i, j)) computed tile after tile
+		template <typename F>
+		Matrix zip(const Matrix& W, F f) const;
+
+		//this(i, j) = f(this(i, j), W(i, j)) computed tile after tile
+		template <typename F>
+		void update(const Matrix& W, F f);
+
+		//this(i, j) = f(this(i, j)) computed tile after tile
+		template <typename F>
+		void update(F f);
+
+	public:
+		//default constructor
+		Matrix();
+
+		//constructor
+		Matrix(const size_t& M, const size_t& N);
+
+		//constructor leaving the fields uninitialized, they have to be written before being read
+		Matrix(const size_t& M, const size_t& N, Uninitialized_t);
+
+		//constructor assigning values generated by the function in row-major order
+		template <typename Generator> requires std::is_invocable_r_v<T, Generator&>
+		Matrix(const size_t& M, const size_t& N, Generator W);
+
+		//constructor copying M*N values stored row after row
+		Matrix(const size_t& M, const size_t& N, std::span<const T> values) noexcept(false);
+
+		//conversion from the row-major layout
+		explicit Matrix(const Matrix<T>& A);
+
+		//copying constructor, shares the fields of Q until either matrix is written;
+		//fields exposed by non-const access of Q are copied right away, which may throw std::bad_alloc
+		Matrix(const Matrix& Q) noexcept(false);
+
+		//moving constructor, Q is left empty
+		Matrix(Matrix&& Q) noexcept;
+
+		//conversion to the row-major layout
+		Matrix<T> toRowMajor() const;
+
+		//accesses field without boundary checks
+		T& operator()(const size_t& Row, const size_t& Col) { return context.expose()[index(Row, Col)]; }
+
+		const T& operator()(const size_t& Row, const size_t& Col) const { return context.read()[index(Row, Col)]; }
+
+		//accesses field with boundary checks
+		T& at(const size_t& Row, const size_t& Col) noexcept(false) { if (Row >= rows || Col >= columns) { throw std::out_of_range("Matrix field out of range!"); } return (*this)(Row, Col); }
+
+		const T& at(const size_t& Row, const size_t& Col) const noexcept(false) { if (Row >= rows || Col >= columns) { throw std::out_of_range("Matrix field out of range!"); } return (*this)(Row, Col); }
+
+		//returns true iff two objects have are equal
+		bool operator==(const Matrix& other) const;
+
+		//copies object, sharing the fields until either matrix is written unless non-const access exposed them
+		Matrix& operator=(const Matrix& index) noexcept(false);
+
+		//takes over the storage of index, which is left empty
+		Matrix& operator=(Matrix&& index) noexcept;
+
+		//addition of matrices
+		Matrix operator+(const Matrix& W) const noexcept(false);
+
+		//subtraction of matrices
+		Matrix operator-(const Matrix& W) const noexcept(false);
+
+		//scalar multiplication
+		Matrix operator*(const T& C) const noexcept;
+
+		//scalar multiplication (by the inverse of arg)
+		Matrix operator/(const T& C) const noexcept(false);
+
+		//matrix multiplication, tile by tile on the gemm kernel
+		Matrix operator*(const Matrix& B) const noexcept(false);
+
+		//matrix addition
+		Matrix& operator+=(const Matrix& W) noexcept(false);
+
+		//matrix subtraction
+		Matrix& operator-=(const Matrix& W) noexcept(false);
+
+		//scalar multiplication
+		Matrix& operator*=(const T& C) noexcept(false);
+
+		//matrix multiplication
+		Matrix& operator*=(const Matrix& W) noexcept(false);
+
+		//scalar multiplication
+		Matrix& operator/=(const T& C) noexcept(false);
+
+		//return matrix's transposition, tiles are transposed whole
+		Matrix transposed() const noexcept;
+
+		//return the dot product of two matrices
+		const T dot(const Matrix& B) const noexcept(false);
+
+		//print to std IO-stream
+		void print(std::ostream& out = std::cout) const noexcept;
+
+		//add another column to matrix
+		void expandColumn(const std::vector<T>& newCol) noexcept(false);
+
+		//add another row to matrix
+		void expandRow(const std::vector<T>& newRow) noexcept(false);
+
+		//add count rows stored one after another in values
+		void appendRows(std::span<const T> values, const size_t& count) noexcept(false);
+
+		//add count columns stored one after another (each column contiguous) in values
+		void appendColumns(std::span<const T> values, const size_t& count) noexcept(false);
+
+		//preallocate tiles for given number of rows and columns, keeps the contents
+		void reserve(const size_t& rowCapacity, const size_t& columnCapacity);
+
+		//release the tiles lying outside the matrix
+		void shrink_to_fit();
+
+		size_t getCapacityRows() const noexcept { return tileRows * Size; }
+		size_t getCapacityColumns() const noexcept { return tileColumns * Size; }
+
+		//returns row of given index (from 0 to N-1)
+		std::vector<T> extractRow(size_t index) const noexcept;
+
+		//returns column of given index (from 0 to N-1)
+		std::vector<T> extractColumn(size_t index) const noexcept;
+
+		//change values in a given row
+		void changeRow(const std::vector<T>& row, const size_t& index) noexcept(false);
+
+		//change values in a given column
+		void changeColumn(const std::vector<T>& column, const size_t& index) noexcept(false);
+
+		void copyFrom(const Matrix& D) noexcept;
+
+		void free() noexcept;
+
+		//returns the sum of all the elements of the matrix, integer sums throw std::overflow_error instead of wrapping
+		const T sum() const noexcept(false);
+
+		//return the supremum of set consisting of all the fields in matrix (zero for empty matrix)
+		const T max() const noexcept;
+
+		//element wise multiplication of two matrices
+		Matrix hadamardProduct(const Matrix& B) const noexcept(false);
+
+		Matrix applyOperation(const Matrix& other, std::function<T(const T&, const T&)> f) const noexcept(false);
+
+		Matrix applyOperation(std::function<T(const T&)> f) const noexcept;
+
+		//modifying functions detach shared tiles first, which may throw std::bad_alloc
+		Matrix modify(std::function<void(T&)> f) noexcept(false);
+
+		Matrix modify(std::function<T(const T&)> f) noexcept(false);
+
+		size_t getCountRows() const noexcept { return rows; }
+		size_t getCountColumns() const noexcept { return columns; }
+
+		//raw storage, tile (I, J) is one of the consecutive blocks of TileFields fields
+		T* data() { return context.expose().data(); }
+		const T* data() const noexcept { return context.read().data(); }
+		static constexpr size_t getTileSize() noexcept { return Size; }
+
+		bool empty() const noexcept { return rows == 0 || columns == 0; }
+
+		//determinant, cofactor, adjoint and inverse run on the row-major layout
+		T det() const noexcept(false) { return toRowMajor().det(); }
+
+		T cofactor(const size_t& i, const size_t& j) const noexcept(false) { return toRowMajor().cofactor(i, j); }
+
+		Matrix adjoint() const noexcept(false) { return Matrix(toRowMajor().adjoint()); }
+
+		Matrix inverse() const noexcept(false) { return Matrix(toRowMajor().inverse()); }
+	};
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix() :context(), slots(layout(0, 0)), rows(0), columns(0), tileRows(0), tileColumns(0)
+	{
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix(const size_t& M, const size_t& N)
+		:context(Storage(tilesFor(M) * tilesFor(N) * TileFields, T(0))), slots(layout(tilesFor(M), tilesFor(N))), rows(M), columns(N), tileRows(tilesFor(M)), tileColumns(tilesFor(N))
+	{
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix(const size_t& M, const size_t& N, Uninitialized_t)
+		:context(Storage(tilesFor(M) * tilesFor(N) * TileFields)), slots(layout(tilesFor(M), tilesFor(N))), rows(M), columns(N), tileRows(tilesFor(M)), tileColumns(tilesFor(N))
+	{
+		clearPadding();
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	template <typename Generator> requires std::is_invocable_r_v<T, Generator&>
+	Matrix<T, Tiled<Size, Order>>::Matrix(const size_t& M, const size_t& N, Generator W) :Matrix(M, N, Uninitialized)
+	{
+		T* fields = context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				fields[index(i, j)] = W();
+			}
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix(const size_t& M, const size_t& N, std::span<const T> values) noexcept(false) :Matrix()
+	{
+		if (values.size() != M * N)
+		{
+			throw std::invalid_argument("Number of values doesn't match dimensions of the matrix!");
+		}
+		*this = Matrix(M, N, Uninitialized);
+		T* fields = context.write().data();
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			for (size_t r = 0; r < height; r++)
+			{
+				std::copy_n(values.begin() + (I * Size + r) * N + J * Size, width, fields + offset(I, J) + r * Size);
+			}
+		}, true);
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix(const Matrix<T>& A) :Matrix(A.getCountRows(), A.getCountColumns(), Uninitialized)
+	{
+		const T* source = A.data();
+		const size_t stride = A.getStride();
+		T* fields = context.write().data();
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			for (size_t r = 0; r < height; r++)
+			{
+				std::copy_n(source + (I * Size + r) * stride + J * Size, width, fields + offset(I, J) + r * Size);
+			}
+		}, true);
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix(const Matrix& Q) noexcept(false)
+		:context(Q.context), slots(Q.slots), rows(Q.rows), columns(Q.columns), tileRows(Q.tileRows), tileColumns(Q.tileColumns)
+	{
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>::Matrix(Matrix&& Q) noexcept
+		:context(std::move(Q.context)), slots(Q.slots), rows(Q.rows), columns(Q.columns), tileRows(Q.tileRows), tileColumns(Q.tileColumns)
+	{
+		Q.free();
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T> Matrix<T, Tiled<Size, Order>>::toRowMajor() const
+	{
+		Matrix<T> A(rows, columns, Uninitialized);
+		T* target = A.context.write().data();
+		const size_t stride = A.getStride();
+		const T* fields = context.read().data();
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			for (size_t r = 0; r < height; r++)
+			{
+				std::copy_n(fields + offset(I, J) + r * Size, width, target + (I * Size + r) * stride + J * Size);
+			}
+		}, true);
+		return A;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::regrid(const size_t& newTileRows, const size_t& newTileColumns)
+	{
+		Storage moved(newTileRows * newTileColumns * TileFields, T(0));
+		std::shared_ptr<const std::vector<size_t>> newSlots = layout(newTileRows, newTileColumns);
+		const T* fields = context.read().data();
+		for (size_t I = 0; I < std::min(tileRows, newTileRows); I++)
+		{
+			for (size_t J = 0; J < std::min(tileColumns, newTileColumns); J++)
+			{
+				std::copy_n(fields + offset(I, J), TileFields, moved.begin() + (*newSlots)[I * newTileColumns + J] * TileFields);
+			}
+		}
+		context = detail::SharedBuffer<Storage>(std::move(moved));
+		slots = std::move(newSlots);
+		tileRows = newTileRows;
+		tileColumns = newTileColumns;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::grow(const size_t& newRows, const size_t& newColumns)
+	{
+		const size_t neededRows = tilesFor(newRows), neededColumns = tilesFor(newColumns);
+		if (neededRows > tileRows || neededColumns > tileColumns)
+		{
+			regrid(neededRows > tileRows ? std::max(neededRows, 2 * tileRows) : tileRows, neededColumns > tileColumns ? std::max(neededColumns, 2 * tileColumns) : tileColumns);
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::clearPadding()
+	{
+		if (rows == tileRows * Size && columns == tileColumns * Size)
+		{
+			return;
+		}
+		T* fields = context.write().data();
+		for (size_t I = 0; I < tileRows; I++)
+		{
+			for (size_t J = 0; J < tileColumns; J++)
+			{
+				const size_t height = I * Size < rows ? std::min(Size, rows - I * Size) : 0;
+				const size_t width = J * Size < columns ? std::min(Size, columns - J * Size) : 0;
+				if (height == Size && width == Size)
+				{
+					continue;
+				}
+				T* tile = fields + offset(I, J);
+				for (size_t r = 0; r < Size; r++)
+				{
+					std::fill(tile + r * Size + (r < height ? width : 0), tile + (r + 1) * Size, T(0));
+				}
+			}
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	template <typename F>
+	void Matrix<T, Tiled<Size, Order>>::forTiles(F f, bool parallel) const
+	{
+		const size_t gridColumns = tilesFor(columns), count = tilesFor(rows) * gridColumns;
+		auto body = [&](size_t first, size_t last)
+		{
+			for (size_t t = first; t < last; t++)
+			{
+				const size_t I = t / gridColumns, J = t % gridColumns;
+				f(I, J, std::min(Size, rows - I * Size), std::min(Size, columns - J * Size));
+			}
+		};
+		if (parallel)
+		{
+			ThreadPool::shared().parallelFor(0, count, std::max<size_t>(1, detail::TileGrain / TileFields), body);
+		}
+		else
+		{
+			body(0, count);
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	template <typename F>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::zip(const Matrix& W, F f) const
+	{
+		Matrix R(rows, columns, Uninitialized);
+		const T* a = context.read().data();
+		const T* b = W.context.read().data();
+		T* c = R.context.write().data();
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			const T* x = a + offset(I, J);
+			const T* y = b + W.offset(I, J);
+			T* z = c + R.offset(I, J);
+			for (size_t r = 0; r < height; r++)
+			{
+				for (size_t s = 0; s < width; s++)
+				{
+					z[r * Size + s] = f(x[r * Size + s], y[r * Size + s]);
+				}
+			}
+		}, true);
+		return R;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	template <typename F>
+	void Matrix<T, Tiled<Size, Order>>::update(const Matrix& W, F f)
+	{
+		T* a = context.write().data();
+		const T* b = W.context.read().data();
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			T* x = a + offset(I, J);
+			const T* y = b + W.offset(I, J);
+			for (size_t r = 0; r < height; r++)
+			{
+				for (size_t s = 0; s < width; s++)
+				{
+					x[r * Size + s] = f(x[r * Size + s], y[r * Size + s]);
+				}
+			}
+		}, true);
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	template <typename F>
+	void Matrix<T, Tiled<Size, Order>>::update(F f)
+	{
+		T* a = context.write().data();
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			T* x = a + offset(I, J);
+			for (size_t r = 0; r < height; r++)
+			{
+				for (size_t s = 0; s < width; s++)
+				{
+					x[r * Size + s] = f(x[r * Size + s]);
+				}
+			}
+		}, true);
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	bool Matrix<T, Tiled<Size, Order>>::operator==(const Matrix& other) const
+	{
+		if (rows != other.rows || columns != other.columns)
+		{
+			return false;
+		}
+		const T* a = context.read().data();
+		const T* b = other.context.read().data();
+		bool equal = true;
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			for (size_t r = 0; r < height && equal; r++)
+			{
+				equal = std::equal(a + offset(I, J) + r * Size, a + offset(I, J) + r * Size + width, b + other.offset(I, J) + r * Size);
+			}
+		}, false);
+		return equal;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator=(const Matrix& index) noexcept(false)
+	{
+		if (this == &index)
+		{
+			return *this;
+		}
+		context = index.context;
+		slots = index.slots;
+		rows = index.rows;
+		columns = index.columns;
+		tileRows = index.tileRows;
+		tileColumns = index.tileColumns;
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator=(Matrix&& index) noexcept
+	{
+		if (this == &index)
+		{
+			return *this;
+		}
+		context = std::move(index.context);
+		slots = index.slots;
+		rows = index.rows;
+		columns = index.columns;
+		tileRows = index.tileRows;
+		tileColumns = index.tileColumns;
+		index.free();
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::operator+(const Matrix& W) const noexcept(false)
+	{
+		if (rows != W.rows || columns != W.columns)
+		{
+			throw std::invalid_argument("Addition of matrices is undefined!");
+		}
+		return zip(W, [](const T& a, const T& b) { return T(a + b); });
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::operator-(const Matrix& W) const noexcept(false)
+	{
+		if (rows != W.rows || columns != W.columns)
+		{
+			throw std::invalid_argument("Subtraction of matrices is undefined!");
+		}
+		return zip(W, [](const T& a, const T& b) { return T(a - b); });
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::operator*(const T& C) const noexcept
+	{
+		return zip(*this, [&C](const T& a, const T&) { return T(a * C); });
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::operator/(const T& C) const noexcept(false)
+	{
+		if (!C)
+		{
+			throw std::invalid_argument("Division by zero is undefined!");
+		}
+		return zip(*this, [&C](const T& a, const T&) { return T(a / C); });
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::operator*(const Matrix& B) const noexcept(false)
+	{
+		if (columns != B.rows)
+		{
+			throw std::invalid_argument("Matrix multiplication undefined!");
+		}
+		if constexpr (detail::isExactInteger<T>)
+		{
+			//the exact kernel needs whole rows to accumulate in the widened type
+			return Matrix(toRowMajor() * B.toRowMajor());
+		}
+		Matrix R(rows, B.columns, Uninitialized);
+		const size_t depth = tilesFor(columns), gridColumns = tilesFor(B.columns), count = tilesFor(rows) * gridColumns;
+		const T* a = context.read().data();
+		const T* b = B.context.read().data();
+		T* c = R.context.write().data();
+		//every output tile is accumulated from full tile products, the zero padding cancels out the fields past the edges
+		ThreadPool::shared().parallelFor(0, count, 1, [&](size_t first, size_t last)
+		{
+			for (size_t t = first; t < last; t++)
+			{
+				const size_t I = t / gridColumns, J = t % gridColumns;
+				T* tile = c + R.offset(I, J);
+				if (depth == 0)
+				{
+					std::fill_n(tile, TileFields, T(0));
+				}
+				for (size_t K = 0; K < depth; K++)
+				{
+					detail::gemm(Size, Size, Size, T(1), a + offset(I, K), Size, false, b + B.offset(K, J), Size, false, K ? T(1) : T(0), tile, Size);
+				}
+			}
+		});
+		//non-finite fields may have leaked into the padding through 0*inf
+		R.clearPadding();
+		return R;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator+=(const Matrix& W) noexcept(false)
+	{
+		if (rows != W.rows || columns != W.columns)
+		{
+			throw std::invalid_argument("Addition of matrices is undefined!");
+		}
+		update(W, [](const T& a, const T& b) { return T(a + b); });
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator-=(const Matrix& W) noexcept(false)
+	{
+		if (rows != W.rows || columns != W.columns)
+		{
+			throw std::invalid_argument("Subtraction of matrices is undefined!");
+		}
+		update(W, [](const T& a, const T& b) { return T(a - b); });
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator*=(const T& C) noexcept(false)
+	{
+		update([&C](const T& a) { return T(a * C); });
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator*=(const Matrix& W) noexcept(false)
+	{
+		*this = (*this) * W;
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>>& Matrix<T, Tiled<Size, Order>>::operator/=(const T& C) noexcept(false)
+	{
+		if (!C)
+		{
+			throw std::invalid_argument("Division by zero is undefined!");
+		}
+		update([&C](const T& a) { return T(a / C); });
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::transposed() const noexcept
+	{
+		Matrix R(columns, rows, Uninitialized);
+		const T* a = context.read().data();
+		T* c = R.context.write().data();
+		//the padding of a tile transposes onto the padding of its image, so whole tiles are copied
+		forTiles([&](size_t I, size_t J, size_t, size_t)
+		{
+			const T* source = a + offset(I, J);
+			T* target = c + R.offset(J, I);
+			for (size_t r = 0; r < Size; r++)
+			{
+				for (size_t s = 0; s < Size; s++)
+				{
+					target[s * Size + r] = source[r * Size + s];
+				}
+			}
+		}, true);
+		return R;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	const T Matrix<T, Tiled<Size, Order>>::dot(const Matrix& B) const noexcept(false)
+	{
+		if (B.rows != rows || B.columns != columns)
+		{
+			throw std::invalid_argument("Dot product is undefined for matrices of different dimensions!");
+		}
+		const T* a = context.read().data();
+		const T* b = B.context.read().data();
+		if constexpr (detail::isExactInteger<T>)
+		{
+			detail::Widened<T> s(0);
+			forTiles([&](size_t I, size_t J, size_t height, size_t width)
+			{
+				for (size_t r = 0; r < height; r++)
+				{
+					for (size_t c = 0; c < width; c++)
+					{
+						s = detail::checkedAdd(s, detail::checkedMul(detail::Widened<T>(b[B.offset(I, J) + r * Size + c]), detail::Widened<T>(a[offset(I, J) + r * Size + c])));
+					}
+				}
+			}, false);
+			return detail::narrow<T>(s);
+		}
+		T s(0);
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			for (size_t r = 0; r < height; r++)
+			{
+				for (size_t c = 0; c < width; c++)
+				{
+					s += b[B.offset(I, J) + r * Size + c] * a[offset(I, J) + r * Size + c];
+				}
+			}
+		}, false);
+		return s;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::print(std::ostream& out) const noexcept
+	{
+		for (size_t i = 0; i < rows; i++)
+		{
+			out << "|";
+			for (size_t j = 0; j < columns; j++)
+			{
+				out << (*this)(i, j) << "|";
+			}
+			out << "\n";
+		}
+		out << "\n";
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::expandColumn(const std::vector<T>& newCol) noexcept(false)
+	{
+		if (newCol.size() != rows && rows != 0)
+		{
+			throw std::invalid_argument("New column has to have as many records as there are rows!");
+		}
+		if (rows == 0)
+		{
+			//padding is zero, so existing columns read as zero in the new rows
+			rows = newCol.size();
+		}
+		grow(rows, columns + 1);
+		T* fields = context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			fields[index(i, columns)] = newCol[i];
+		}
+		columns++;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::expandRow(const std::vector<T>& newRow) noexcept(false)
+	{
+		if (newRow.size() != columns && columns != 0)
+		{
+			throw std::invalid_argument("New row has to have as many records as there are columns!");
+		}
+		if (columns == 0)
+		{
+			columns = newRow.size();
+		}
+		grow(rows + 1, columns);
+		T* fields = context.write().data();
+		for (size_t j = 0; j < columns; j++)
+		{
+			fields[index(rows, j)] = newRow[j];
+		}
+		rows++;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::appendRows(std::span<const T> values, const size_t& count) noexcept(false)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if (values.size() % count != 0 || (columns != 0 && values.size() != count * columns))
+		{
+			throw std::invalid_argument("New rows have to have as many records as there are columns!");
+		}
+		if (columns == 0)
+		{
+			columns = values.size() / count;
+		}
+		grow(rows + count, columns);
+		T* fields = context.write().data();
+		for (size_t i = 0; i < count; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				fields[index(rows + i, j)] = values[i * columns + j];
+			}
+		}
+		rows += count;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::appendColumns(std::span<const T> values, const size_t& count) noexcept(false)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		if (values.size() % count != 0 || (rows != 0 && values.size() != count * rows))
+		{
+			throw std::invalid_argument("New columns have to have as many records as there are rows!");
+		}
+		if (rows == 0)
+		{
+			//padding is zero, so existing columns read as zero in the new rows
+			rows = values.size() / count;
+		}
+		grow(rows, columns + count);
+		T* fields = context.write().data();
+		for (size_t j = 0; j < count; j++)
+		{
+			for (size_t i = 0; i < rows; i++)
+			{
+				fields[index(i, columns + j)] = values[j * rows + i];
+			}
+		}
+		columns += count;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::reserve(const size_t& rowCapacity, const size_t& columnCapacity)
+	{
+		if (tilesFor(rowCapacity) > tileRows || tilesFor(columnCapacity) > tileColumns)
+		{
+			regrid(std::max(tileRows, tilesFor(rowCapacity)), std::max(tileColumns, tilesFor(columnCapacity)));
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::shrink_to_fit()
+	{
+		if (tilesFor(rows) != tileRows || tilesFor(columns) != tileColumns)
+		{
+			regrid(tilesFor(rows), tilesFor(columns));
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	std::vector<T> Matrix<T, Tiled<Size, Order>>::extractRow(size_t index) const noexcept
+	{
+		std::vector<T> A;
+		A.reserve(columns);
+		for (size_t j = 0; j < columns; j++)
+		{
+			A.push_back((*this)(index, j));
+		}
+		return A;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	std::vector<T> Matrix<T, Tiled<Size, Order>>::extractColumn(size_t index) const noexcept
+	{
+		std::vector<T> A;
+		A.reserve(rows);
+		for (size_t i = 0; i < rows; i++)
+		{
+			A.push_back((*this)(i, index));
+		}
+		return A;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::changeRow(const std::vector<T>& row, const size_t& index) noexcept(false)
+	{
+		if (row.size() != columns)
+		{
+			throw std::invalid_argument("Dimension of vector provided doesn't match dimensions of the matrix!");
+		}
+		T* fields = context.write().data();
+		for (size_t j = 0; j < columns; j++)
+		{
+			fields[this->index(index, j)] = row[j];
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::changeColumn(const std::vector<T>& column, const size_t& index) noexcept(false)
+	{
+		if (column.size() != rows)
+		{
+			throw std::invalid_argument("Dimension of vector provided doesn't match dimensions of the matrix!");
+		}
+		T* fields = context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			fields[this->index(i, index)] = column[i];
+		}
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::copyFrom(const Matrix& D) noexcept
+	{
+		*this = D;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	void Matrix<T, Tiled<Size, Order>>::free() noexcept
+	{
+		context = detail::SharedBuffer<Storage>();
+		rows = 0;
+		columns = 0;
+		tileRows = 0;
+		tileColumns = 0;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	const T Matrix<T, Tiled<Size, Order>>::sum() const noexcept(false)
+	{
+		//the padding is zero, so whole tiles are summed
+		const Storage& fields = context.read();
+		if constexpr (detail::isExactInteger<T>)
+		{
+			detail::Widened<T> S(0);
+			for (const T& Q : fields)
+			{
+				S = detail::checkedAdd(S, detail::Widened<T>(Q));
+			}
+			return detail::narrow<T>(S);
+		}
+		T S(0);
+		for (const T& Q : fields)
+		{
+			S += Q;
+		}
+		return S;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	const T Matrix<T, Tiled<Size, Order>>::max() const noexcept
+	{
+		if (empty())
+		{
+			return T(0);
+		}
+		const T* fields = context.read().data();
+		T supremum = (*this)(0, 0);
+		forTiles([&](size_t I, size_t J, size_t height, size_t width)
+		{
+			for (size_t r = 0; r < height; r++)
+			{
+				for (size_t c = 0; c < width; c++)
+				{
+					const T& value = fields[offset(I, J) + r * Size + c];
+					if (value > supremum)
+					{
+						supremum = value;
+					}
+				}
+			}
+		}, false);
+		return supremum;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::hadamardProduct(const Matrix& B) const noexcept(false)
+	{
+		if (B.rows != rows || B.columns != columns)
+		{
+			throw std::invalid_argument("Hadamard product is undefined for matrices of different dimensions!");
+		}
+		return zip(B, [](const T& a, const T& b) { return T(a * b); });
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::applyOperation(const Matrix& other, std::function<T(const T&, const T&)> f) const noexcept(false)
+	{
+		if (other.rows != rows || other.columns != columns)
+		{
+			throw std::invalid_argument("Function applyOperation is undefined for matrices of different dimensions!");
+		}
+		//user functions see the fields in row-major order, one at a time
+		Matrix result(rows, columns, Uninitialized);
+		T* fields = result.context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				fields[result.index(i, j)] = f((*this)(i, j), other(i, j));
+			}
+		}
+		return result;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::applyOperation(std::function<T(const T&)> f) const noexcept
+	{
+		Matrix result(rows, columns, Uninitialized);
+		T* fields = result.context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				fields[result.index(i, j)] = f((*this)(i, j));
+			}
+		}
+		return result;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::modify(std::function<void(T&)> f) noexcept(false)
+	{
+		T* fields = context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				f(fields[index(i, j)]);
+			}
+		}
+		return *this;
+	}
+
+	template <typename T, size_t Size, TileOrder Order>
+	Matrix<T, Tiled<Size, Order>> Matrix<T, Tiled<Size, Order>>::modify(std::function<T(const T&)> f) noexcept(false)
+	{
+		T* fields = context.write().data();
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < columns; j++)
+			{
+				fields[index(i, j)] = f(fields[index(i, j)]);
+			}
+		}
+		return *this;
+	}
+}